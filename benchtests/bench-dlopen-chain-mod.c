@@ -0,0 +1,38 @@
+/* Module for the dlopen-chain benchmark.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* This file is compiled once for every link of the chain.  N is the
+   number of the module, and NEXT the number of the module it is linked
+   against, if any.  */
+
+#define CONCAT1(a, b) a##b
+#define CONCAT(a, b) CONCAT1 (a, b)
+
+#ifdef NEXT
+extern int CONCAT (chain_link, NEXT) (void);
+#endif
+
+int
+CONCAT (chain_link, N) (void)
+{
+#ifdef NEXT
+  return CONCAT (chain_link, NEXT) () + 1;
+#else
+  return 1;
+#endif
+}
@@ -0,0 +1,185 @@
+/* Measure dlopen and dlclose of a chain of dependent shared objects.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "dlopen-chain"
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench-timing.h"
+#include "json-lib.h"
+
+/* Module NN of the chain, for NN from 00 to CHAIN_LENGTH - 1, is linked
+   against module NN + 1.  This must match the list of modules in the
+   Makefile.  */
+#define CHAIN_LENGTH 100
+
+/* Number of times each operation is measured.  */
+#define ROUNDS 32
+
+static void *handles[CHAIN_LENGTH];
+
+static void
+module_name (char *buf, size_t size, int n)
+{
+  snprintf (buf, size, "%sbench-dlopen-chain-mod%02d.so", PFX, n);
+}
+
+static void *
+xdlopen (int n, int flags)
+{
+  char name[sizeof (PFX) + 64];
+  module_name (name, sizeof (name), n);
+  void *h = dlopen (name, flags);
+  if (h == NULL)
+    {
+      printf ("error: dlopen: %s\n", dlerror ());
+      exit (1);
+    }
+  return h;
+}
+
+static void
+xdlclose (void *h)
+{
+  if (dlclose (h) != 0)
+    {
+      printf ("error: dlclose: %s\n", dlerror ());
+      exit (1);
+    }
+}
+
+struct stats
+{
+  timing_t total;
+  timing_t min;
+  timing_t max;
+  unsigned long iters;
+};
+
+static void
+stats_add (struct stats *s, timing_t t)
+{
+  TIMING_ACCUM (s->total, t);
+  if (s->iters == 0 || t < s->min)
+    s->min = t;
+  if (s->iters == 0 || t > s->max)
+    s->max = t;
+  s->iters++;
+}
+
+static void
+stats_print (json_ctx_t *js, const char *name, const struct stats *s)
+{
+  json_attr_object_begin (js, name);
+  json_attr_double (js, "duration", (double) s->total);
+  json_attr_double (js, "iterations", (double) s->iters);
+  json_attr_double (js, "mean", (double) s->total / (double) s->iters);
+  json_attr_double (js, "min", (double) s->min);
+  json_attr_double (js, "max", (double) s->max);
+  json_attr_object_end (js);
+}
+
+/* Open the head of the chain, which loads and sorts all modules with a
+   single dlopen call, and close it again.  */
+static void
+bench_head (json_ctx_t *js)
+{
+  struct stats open_stats = { 0 }, close_stats = { 0 };
+
+  for (int round = 0; round < ROUNDS; round++)
+    {
+      timing_t start, stop, cur;
+
+      TIMING_NOW (start);
+      void *h = xdlopen (0, RTLD_NOW);
+      TIMING_NOW (stop);
+      TIMING_DIFF (cur, start, stop);
+      stats_add (&open_stats, cur);
+
+      TIMING_NOW (start);
+      xdlclose (h);
+      TIMING_NOW (stop);
+      TIMING_DIFF (cur, start, stop);
+      stats_add (&close_stats, cur);
+    }
+
+  stats_print (js, "head-dlopen", &open_stats);
+  stats_print (js, "head-dlclose", &close_stats);
+}
+
+/* Open the modules one at a time into the global scope, starting at
+   the tail of the chain, so that every dlopen adds one object on top of
+   the ones already loaded.  Then close them again, starting at the
+   head.  */
+static void
+bench_incremental (json_ctx_t *js)
+{
+  struct stats open_stats = { 0 }, close_stats = { 0 };
+
+  for (int round = 0; round < ROUNDS; round++)
+    {
+      timing_t start, stop, cur;
+
+      for (int n = CHAIN_LENGTH - 1; n >= 0; n--)
+	{
+	  TIMING_NOW (start);
+	  handles[n] = xdlopen (n, RTLD_NOW | RTLD_GLOBAL);
+	  TIMING_NOW (stop);
+	  TIMING_DIFF (cur, start, stop);
+	  stats_add (&open_stats, cur);
+	}
+
+      for (int n = 0; n < CHAIN_LENGTH; n++)
+	{
+	  TIMING_NOW (start);
+	  xdlclose (handles[n]);
+	  TIMING_NOW (stop);
+	  TIMING_DIFF (cur, start, stop);
+	  stats_add (&close_stats, cur);
+	}
+    }
+
+  stats_print (js, "incremental-dlopen", &open_stats);
+  stats_print (js, "incremental-dlclose", &close_stats);
+}
+
+int
+do_bench (void)
+{
+  json_ctx_t json_ctx;
+
+  /* Load and unload the chain once so that the files are in the page
+     cache.  */
+  xdlclose (xdlopen (0, RTLD_NOW));
+
+  json_init (&json_ctx, 2, stdout);
+  json_attr_object_begin (&json_ctx, "dlopen_chain");
+
+  bench_head (&json_ctx);
+  bench_incremental (&json_ctx);
+
+  json_attr_object_end (&json_ctx);
+
+  return 0;
+}
+
+#define TEST_FUNCTION do_bench ()
+
+#include "../test-skeleton.c"
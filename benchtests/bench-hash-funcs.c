@@ -0,0 +1,185 @@
+/* Measure the string hash functions of <poly-hash.h>.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#define TEST_MAIN
+#define TEST_NAME "hash-funcs"
+#define TEST_FUNCTION test_main ()
+#include "bench-timing.h"
+#include "json-lib.h"
+#include "bench-util.h"
+
+#include <poly-hash.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The hash of ld.so symbol lookups and hsearch, and of NSS and nscd,
+   each computed with the kernel and one byte at a time.  The byte-wise
+   versions are the reference for the hash values.  */
+
+static uint32_t __attribute__ ((noinline))
+dl_new_hash (const char *key, size_t len)
+{
+  return poly_hash_string (5381, key, 33);
+}
+
+static uint32_t __attribute__ ((noinline))
+dl_new_hash_bytewise (const char *key, size_t len)
+{
+  uint32_t h = 5381;
+  for (unsigned char c = *key; c != '\0'; c = *++key)
+    h = h * 33 + c;
+  return h;
+}
+
+static uint32_t __attribute__ ((noinline))
+nss_hash (const char *key, size_t len)
+{
+  return poly_hash_bytes (0, key, len, 65599);
+}
+
+static uint32_t __attribute__ ((noinline))
+nss_hash_bytewise (const char *key, size_t len)
+{
+  const unsigned char *s = (const unsigned char *) key;
+  uint32_t h = 0;
+  while (len-- > 0)
+    h = *s++ + 65599 * h;
+  return h;
+}
+
+typedef uint32_t (*proto_t) (const char *, size_t);
+
+typedef struct
+{
+  const char *name;
+  proto_t fn;
+  proto_t ref;
+} impl_t;
+
+#define IMPL(name) { #name, name, name ## _bytewise }, \
+		   { #name "_bytewise", name ## _bytewise, name ## _bytewise }
+
+static const impl_t test_list[] =
+{
+  IMPL (dl_new_hash),
+  IMPL (nss_hash)
+};
+
+#define NKEYS 4096
+#define MAX_KEY_LEN 128
+#define KEYS_PER_TEST (NKEYS * 256)
+
+static char keys[NKEYS][MAX_KEY_LEN + 1];
+static size_t key_lens[NKEYS];
+
+/* Fill KEYS with identifier-like strings of MIN_LEN to MAX_LEN bytes.  */
+static void
+init_keys (size_t min_len, size_t max_len)
+{
+  static const char chars[] = "abcdefghijklmnopqrstuvwxyz"
+			      "ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789";
+
+  for (size_t i = 0; i < NKEYS; i++)
+    {
+      size_t len = min_len + rand () % (max_len - min_len + 1);
+      for (size_t j = 0; j < len; j++)
+	keys[i][j] = chars[rand () % (sizeof (chars) - 1)];
+      keys[i][len] = '\0';
+      key_lens[i] = len;
+    }
+}
+
+static void
+do_one_test (json_ctx_t *json_ctx, const impl_t *impl)
+{
+  timing_t start, stop, cur;
+  struct timespec ts_start, ts_stop;
+  volatile uint32_t sink;
+  uint32_t sum = 0;
+
+  for (size_t i = 0; i < NKEYS; i++)
+    if (impl->fn (keys[i], key_lens[i]) != impl->ref (keys[i], key_lens[i]))
+      {
+	printf ("error: %s: wrong hash for key \"%s\"\n", impl->name,
+		keys[i]);
+	exit (1);
+      }
+
+  clock_gettime (CLOCK_MONOTONIC, &ts_start);
+  TIMING_NOW (start);
+  for (size_t n = 0; n < KEYS_PER_TEST / NKEYS; n++)
+    for (size_t i = 0; i < NKEYS; i++)
+      sum += impl->fn (keys[i], key_lens[i]);
+  TIMING_NOW (stop);
+  clock_gettime (CLOCK_MONOTONIC, &ts_stop);
+  TIMING_DIFF (cur, start, stop);
+  sink = sum;
+  (void) sink;
+
+  double secs = (ts_stop.tv_sec - ts_start.tv_sec)
+		+ (ts_stop.tv_nsec - ts_start.tv_nsec) / 1e9;
+
+  json_attr_object_begin (json_ctx, impl->name);
+  json_attr_double (json_ctx, "duration", cur);
+  json_attr_double (json_ctx, "iterations", KEYS_PER_TEST);
+  json_attr_double (json_ctx, "mean", (double) cur / KEYS_PER_TEST);
+  json_attr_double (json_ctx, "keys-per-second",
+		    secs > 0 ? KEYS_PER_TEST / secs : 0);
+  json_attr_object_end (json_ctx);
+}
+
+static void
+do_test (json_ctx_t *json_ctx, size_t min_len, size_t max_len)
+{
+  char name[32];
+
+  init_keys (min_len, max_len);
+
+  snprintf (name, sizeof (name), "length %zu-%zu", min_len, max_len);
+  json_attr_object_begin (json_ctx, name);
+  for (size_t i = 0; i < sizeof (test_list) / sizeof (test_list[0]); i++)
+    do_one_test (json_ctx, &test_list[i]);
+  json_attr_object_end (json_ctx);
+}
+
+int
+test_main (void)
+{
+  json_ctx_t json_ctx;
+
+  bench_start ();
+
+  json_init (&json_ctx, 2, stdout);
+  json_attr_object_begin (&json_ctx, TEST_NAME);
+
+  do_test (&json_ctx, 1, 8);
+  do_test (&json_ctx, 8, 16);
+  do_test (&json_ctx, 16, 32);
+  do_test (&json_ctx, 32, 64);
+  do_test (&json_ctx, 64, 128);
+  /* Typical symbol names.  */
+  do_test (&json_ctx, 4, 40);
+
+  json_attr_object_end (&json_ctx);
+  return 0;
+}
+
+#include "bench-util.c"
+#include "../test-skeleton.c"
@@ -0,0 +1,29 @@
+/* Caller of the lazily resolved functions in the lazy-bind benchmark.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include "bench-lazy-bind.h"
+
+/* Call every function in bench-lazy-bind-mod.so once, through the
+   PLT.  */
+double
+lazy_bind_call_all (double x)
+{
+#define CALL(n) x = lazy_bind_##n (x);
+  LAZY_BIND_EXPAND (CALL)
+  return x;
+}
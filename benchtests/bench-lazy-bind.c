@@ -0,0 +1,132 @@
+/* Measure the cost of lazy binding on the first call of a function.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Run the benchmark with
+   GLIBC_TUNABLES=glibc.cpu.hwcaps=Prefer_Vector_Resolve to measure the
+   lazy binding trampolines which only save the parameter registers on
+   x86-64.  */
+
+#define TEST_MAIN
+#define TEST_NAME "lazy-bind"
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench-timing.h"
+#include "json-lib.h"
+#include "bench-lazy-bind.h"
+
+/* Number of times the modules are loaded.  */
+#define ROUNDS 32
+
+static void *
+xdlopen (const char *name)
+{
+  void *h = dlopen (name, RTLD_LAZY);
+  if (h == NULL)
+    {
+      printf ("error: dlopen: %s\n", dlerror ());
+      exit (1);
+    }
+  return h;
+}
+
+struct stats
+{
+  timing_t total;
+  timing_t min;
+  timing_t max;
+  unsigned long iters;
+};
+
+static void
+stats_add (struct stats *s, timing_t t)
+{
+  TIMING_ACCUM (s->total, t);
+  if (s->iters == 0 || t < s->min)
+    s->min = t;
+  if (s->iters == 0 || t > s->max)
+    s->max = t;
+  s->iters++;
+}
+
+/* Print the statistics of S, with all values per function call.  */
+static void
+stats_print (json_ctx_t *js, const char *name, const struct stats *s)
+{
+  double calls = LAZY_BIND_FUNCTIONS;
+  json_attr_object_begin (js, name);
+  json_attr_double (js, "duration", (double) s->total);
+  json_attr_double (js, "iterations", (double) s->iters * calls);
+  json_attr_double (js, "mean", (double) s->total / (s->iters * calls));
+  json_attr_double (js, "min", (double) s->min / calls);
+  json_attr_double (js, "max", (double) s->max / calls);
+  json_attr_object_end (js);
+}
+
+int
+do_bench (void)
+{
+  json_ctx_t json_ctx;
+  struct stats first = { 0 }, resolved = { 0 };
+  const char *tunables = getenv ("GLIBC_TUNABLES");
+
+  for (int round = 0; round < ROUNDS; round++)
+    {
+      /* A fresh copy of the modules has unresolved PLT entries.  */
+      void *h = xdlopen (PFX "bench-lazy-bind-caller.so");
+      double (*call_all) (double) = dlsym (h, "lazy_bind_call_all");
+      if (call_all == NULL)
+	{
+	  printf ("error: dlsym: %s\n", dlerror ());
+	  exit (1);
+	}
+
+      timing_t start, stop, cur;
+      TIMING_NOW (start);
+      call_all (0);
+      TIMING_NOW (stop);
+      TIMING_DIFF (cur, start, stop);
+      stats_add (&first, cur);
+
+      TIMING_NOW (start);
+      call_all (0);
+      TIMING_NOW (stop);
+      TIMING_DIFF (cur, start, stop);
+      stats_add (&resolved, cur);
+
+      if (dlclose (h) != 0)
+	{
+	  printf ("error: dlclose: %s\n", dlerror ());
+	  exit (1);
+	}
+    }
+
+  json_init (&json_ctx, 2, stdout);
+  json_attr_object_begin (&json_ctx, "lazy_bind");
+  json_attr_string (&json_ctx, "tunables", tunables != NULL ? tunables : "");
+  stats_print (&json_ctx, "first-call", &first);
+  stats_print (&json_ctx, "resolved-call", &resolved);
+  json_attr_object_end (&json_ctx);
+
+  return 0;
+}
+
+#define TEST_FUNCTION do_bench ()
+
+#include "../test-skeleton.c"
@@ -0,0 +1,46 @@
+/* Functions for the lazy-bind benchmark.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* LAZY_BIND_EXPAND (M) expands to M (NNN) for all three-digit numbers
+   NNN.  */
+
+#define LAZY_BIND_EXPAND10(m, p) \
+  m (p##0) m (p##1) m (p##2) m (p##3) m (p##4) \
+  m (p##5) m (p##6) m (p##7) m (p##8) m (p##9)
+#define LAZY_BIND_EXPAND100(m, p) \
+  LAZY_BIND_EXPAND10 (m, p##0) LAZY_BIND_EXPAND10 (m, p##1) \
+  LAZY_BIND_EXPAND10 (m, p##2) LAZY_BIND_EXPAND10 (m, p##3) \
+  LAZY_BIND_EXPAND10 (m, p##4) LAZY_BIND_EXPAND10 (m, p##5) \
+  LAZY_BIND_EXPAND10 (m, p##6) LAZY_BIND_EXPAND10 (m, p##7) \
+  LAZY_BIND_EXPAND10 (m, p##8) LAZY_BIND_EXPAND10 (m, p##9)
+#define LAZY_BIND_EXPAND(m) \
+  LAZY_BIND_EXPAND100 (m, 0) LAZY_BIND_EXPAND100 (m, 1) \
+  LAZY_BIND_EXPAND100 (m, 2) LAZY_BIND_EXPAND100 (m, 3) \
+  LAZY_BIND_EXPAND100 (m, 4) LAZY_BIND_EXPAND100 (m, 5) \
+  LAZY_BIND_EXPAND100 (m, 6) LAZY_BIND_EXPAND100 (m, 7) \
+  LAZY_BIND_EXPAND100 (m, 8) LAZY_BIND_EXPAND100 (m, 9)
+
+/* Number of functions defined by LAZY_BIND_EXPAND.  */
+#define LAZY_BIND_FUNCTIONS 1000
+
+/* The functions take a floating-point parameter, so that lazy binding
+   has to preserve vector registers.  */
+#define LAZY_BIND_DECLARE(n) extern double lazy_bind_##n (double);
+LAZY_BIND_EXPAND (LAZY_BIND_DECLARE)
+
+extern double lazy_bind_call_all (double);
@@ -124,6 +124,15 @@ test_main (void)
       do_test (8 - i, 2 * i, i, 16 << i, 8 << i, 127);
     }
 
+  /* Longer copies, where the vectorized loops dominate.  */
+  for (i = 256; i <= 4096; i *= 2)
+    {
+      do_test (0, 0, 23, i, i + 64, 127);
+      do_test (1, 3, 23, i, i + 64, 127);
+      do_test (5, 0, 23, i + 64, i, 127);
+      do_test (0, 7, 0, i, i, 255);
+    }
+
   return ret;
 }
 
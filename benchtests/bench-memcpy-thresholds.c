@@ -0,0 +1,148 @@
+/* Measure memcpy throughput around the size thresholds.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Implementations switch strategy at size thresholds, such as the
+   REP MOVSB and non-temporal store thresholds on x86.  This benchmark
+   measures sizes from START_SIZE to MAX_SIZE in steps of a quarter of
+   a doubling, and reports the throughput in bytes per timing unit
+   along with the timings, so that a regression on either side of a
+   threshold shows as a step in the throughput.  The thresholds can be
+   changed with tunables to compare their effect.  */
+
+#ifndef MEMCPY_RESULT
+# define MEMCPY_RESULT(dst, len) dst
+# define START_SIZE 1024
+# define MAX_SIZE (32 * 1024 * 1024)
+# define MIN_PAGE_SIZE (getpagesize () + MAX_SIZE)
+# define TEST_MAIN
+# define TEST_NAME "memcpy"
+# define TIMEOUT (20 * 60)
+# include "bench-string.h"
+
+IMPL (memcpy, 1)
+#endif
+
+#include "json-lib.h"
+
+typedef char *(*proto_t) (char *, const char *, size_t);
+
+/* The number of bytes copied for each size and implementation, so that
+   small sizes are repeated often enough to be measured.  */
+#define BYTES_PER_TEST (16 * 1024 * 1024)
+
+static void
+do_one_test (json_ctx_t *json_ctx, impl_t *impl, char *dst, const char *src,
+	     size_t len, double *throughput)
+{
+  size_t i, iters = BYTES_PER_TEST / len;
+  timing_t start, stop, cur;
+
+  if (iters < 16)
+    iters = 16;
+
+  /* Warm up the caches and the TLB.  */
+  CALL (impl, dst, src, len);
+
+  TIMING_NOW (start);
+  for (i = 0; i < iters; ++i)
+    {
+      CALL (impl, dst, src, len);
+    }
+  TIMING_NOW (stop);
+
+  TIMING_DIFF (cur, start, stop);
+
+  json_element_double (json_ctx, (double) cur / (double) iters);
+  *throughput = cur == 0 ? 0 : (double) len * (double) iters / (double) cur;
+}
+
+static void
+do_test (json_ctx_t *json_ctx, size_t len)
+{
+  size_t i, j, n = 0;
+  char *s1, *s2;
+
+  if (len >= page_size)
+    return;
+
+  FOR_EACH_IMPL (impl, 0)
+    n++;
+  double throughput[n];
+
+  s1 = (char *) buf1;
+  s2 = (char *) buf2;
+
+  for (i = 0, j = 1; i < len; i++, j += 23)
+    s1[i] = j;
+
+  json_element_object_begin (json_ctx);
+  json_attr_uint (json_ctx, "length", (double) len);
+  json_array_begin (json_ctx, "timings");
+
+  i = 0;
+  FOR_EACH_IMPL (impl, 0)
+    do_one_test (json_ctx, impl, s2, s1, len, &throughput[i++]);
+
+  json_array_end (json_ctx);
+  json_array_begin (json_ctx, "throughput");
+  for (j = 0; j < n; j++)
+    json_element_double (json_ctx, throughput[j]);
+  json_array_end (json_ctx);
+  json_element_object_end (json_ctx);
+}
+
+int
+test_main (void)
+{
+  json_ctx_t json_ctx;
+  size_t i;
+
+  test_init ();
+
+  json_init (&json_ctx, 0, stdout);
+
+  json_document_begin (&json_ctx);
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, TEST_NAME);
+  json_attr_string (&json_ctx, "bench-variant", "thresholds");
+
+  json_array_begin (&json_ctx, "ifuncs");
+  FOR_EACH_IMPL (impl, 0)
+    json_element_string (&json_ctx, impl->name);
+  json_array_end (&json_ctx);
+
+  json_array_begin (&json_ctx, "results");
+  for (i = START_SIZE; i <= MAX_SIZE; i <<= 1)
+    {
+      do_test (&json_ctx, i);
+      do_test (&json_ctx, i + i / 4);
+      do_test (&json_ctx, i + i / 2);
+      do_test (&json_ctx, i + 3 * i / 4);
+    }
+
+  json_array_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+
+  return ret;
+}
+
+#include <support/test-driver.c>
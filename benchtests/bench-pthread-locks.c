@@ -124,6 +124,103 @@ test_mutex_trylock (long iters, int filler)
   return cur;
 }
 
+/* Initialize M with the given protocol and robustness.  Returns
+   nonzero if the kernel does not support the requested kind.  */
+static int
+init_mutex_kind (int protocol, int robust)
+{
+  pthread_mutexattr_t attr;
+  int ret;
+
+  pthread_mutexattr_init (&attr);
+  pthread_mutexattr_setprotocol (&attr, protocol);
+  pthread_mutexattr_setrobust (&attr, robust);
+  ret = pthread_mutex_init (&m, &attr);
+  pthread_mutexattr_destroy (&attr);
+  return ret;
+}
+
+/* Return true if mutexes with the given protocol and robustness can
+   be used, so that the benchmarks of unsupported kinds are skipped
+   instead of timing a different kind.  */
+static int
+mutex_kind_supported (int protocol, int robust)
+{
+  if (init_mutex_kind (protocol, robust) != 0)
+    return 0;
+  int ret = pthread_mutex_lock (&m) == 0;
+  if (ret)
+    pthread_mutex_unlock (&m);
+  pthread_mutex_destroy (&m);
+  return ret;
+}
+
+static timing_t
+test_mutex_kind (long iters, int filler, int protocol, int robust)
+{
+  timing_t start, stop, cur;
+
+  init_mutex_kind (protocol, robust);
+
+  TIMING_NOW (start);
+  for (long j = iters; j >= 0; --j)
+    {
+      pthread_mutex_lock (&m);
+      FILLER_GOES_HERE;
+      pthread_mutex_unlock (&m);
+    }
+  TIMING_NOW (stop);
+  TIMING_DIFF (cur, start, stop);
+
+  pthread_mutex_destroy (&m);
+  return cur;
+}
+
+static timing_t
+test_mutex_robust (long iters, int filler)
+{
+  return test_mutex_kind (iters, filler, PTHREAD_PRIO_NONE,
+			  PTHREAD_MUTEX_ROBUST);
+}
+
+static timing_t
+test_mutex_pi (long iters, int filler)
+{
+  return test_mutex_kind (iters, filler, PTHREAD_PRIO_INHERIT,
+			  PTHREAD_MUTEX_STALLED);
+}
+
+static timing_t
+test_mutex_pi_robust (long iters, int filler)
+{
+  return test_mutex_kind (iters, filler, PTHREAD_PRIO_INHERIT,
+			  PTHREAD_MUTEX_ROBUST);
+}
+
+/* Like test_mutex_trylock, this measures a trylock which fails because
+   the mutex is already locked.  */
+static timing_t
+test_mutex_pi_trylock (long iters, int filler)
+{
+  timing_t start, stop, cur;
+
+  init_mutex_kind (PTHREAD_PRIO_INHERIT, PTHREAD_MUTEX_STALLED);
+  pthread_mutex_lock (&m);
+
+  TIMING_NOW (start);
+  for (long j = iters; j >= 0; --j)
+    {
+      pthread_mutex_trylock (&m);
+      FILLER_GOES_HERE;
+    }
+  TIMING_NOW (stop);
+  TIMING_DIFF (cur, start, stop);
+
+  pthread_mutex_unlock (&m);
+  pthread_mutex_destroy (&m);
+  return cur;
+}
+
 static timing_t
 test_rwlock_read (long iters, int filler)
 {
@@ -532,6 +629,15 @@ do_bench (void)
 
   BENCH (mutex);
   BENCH (mutex_trylock);
+  if (mutex_kind_supported (PTHREAD_PRIO_NONE, PTHREAD_MUTEX_ROBUST))
+    BENCH (mutex_robust);
+  if (mutex_kind_supported (PTHREAD_PRIO_INHERIT, PTHREAD_MUTEX_STALLED))
+    {
+      BENCH (mutex_pi);
+      BENCH (mutex_pi_trylock);
+    }
+  if (mutex_kind_supported (PTHREAD_PRIO_INHERIT, PTHREAD_MUTEX_ROBUST))
+    BENCH (mutex_pi_robust);
   BENCH (rwlock_read);
   BENCH (rwlock_tryread);
   BENCH (rwlock_write);
@@ -77,11 +77,11 @@ do_test (size_t align1, size_t align2, size_t len, int max_char,
   if (len == 0)
     return;
 
-  align1 &= 7;
+  align1 &= 63;
   if (align1 + len + 1 >= page_size)
     return;
 
-  align2 &= 7;
+  align2 &= 63;
   if (align2 + len + 1 >= page_size)
     return;
 
@@ -150,6 +150,25 @@ test_main (void)
       do_test (2 * i, i, 8 << i, 254, -1);
     }
 
+  /* Alignments which are not multiples of 8, including those at
+     which a vector load of either string crosses a cache line.  */
+  for (i = 1; i < 32; ++i)
+    {
+      do_test (i, 2 * i, 64, 127, 0);
+      do_test (2 * i, i, 64, 254, 0);
+      do_test (i, 63 - i, 128 + i, 127, 1);
+      do_test (63 - i, i, 128 + i, 254, -1);
+    }
+
+  /* Long strings, which cross page boundaries.  */
+  for (i = 1; i < 5; ++i)
+    {
+      do_test (11 * i, 5 * i, 1500 * i, 127, 0);
+      do_test (5 * i, 11 * i, 1500 * i, 254, 0);
+      do_test (11 * i, 5 * i, 1500 * i, 127, 1);
+      do_test (5 * i, 11 * i, 1500 * i, 254, -1);
+    }
+
   return ret;
 }
 
@@ -174,6 +174,16 @@ test_main (void)
   for (i = 0; i < 64; ++i)
     do_test (0, i, 6);
 
+  /* Long strings, as scanned by tokenizers, with sets which fit into
+     one 16-byte vector and sets which do not.  */
+  for (i = 0; i < 5; ++i)
+    {
+      do_test (0, 256 << i, 3);
+      do_test (3, 256 << i, 12);
+      do_test (0, 256 << i, 24);
+      do_test (5, 256 << i, 64);
+    }
+
   return ret;
 }
 
@@ -194,6 +194,25 @@ typedef struct
   Dl_serpath dls_serpath[1];	/* Actually longer, dls_cnt elements.  */
 # endif
 } Dl_serinfo;
+
+/* Information about the object containing an address, as returned by
+   `_dl_find_object'.  */
+struct dl_find_object
+{
+  __extension__ unsigned long long int dlfo_flags; /* Currently zero.  */
+  void *dlfo_map_start;		/* Beginning of mapping containing address.  */
+  void *dlfo_map_end;		/* End of mapping.  */
+  struct link_map *dlfo_link_map;
+  void *dlfo_eh_frame;		/* Exception handling data of the object.  */
+  __extension__ unsigned long long int __dflo_reserved[7];
+};
+
+/* If ADDRESS is found in an object loaded by the dynamic linker, fill
+   in *RESULT and return 0.  Otherwise, return -1.  This function does
+   not take any locks and is intended for use by unwinders.  The
+   information in *RESULT remains valid until the object is unloaded.  */
+int _dl_find_object (void *__address, struct dl_find_object *__result)
+     __THROW;
 #endif /* __USE_GNU */
 
 
@@ -485,6 +485,52 @@ enum
 			      * sizeof (struct cache_extension_section)))
   };
 
+/* Build the cache_extension_tag_soname_index section for the sorted
+   list of entries.  Store its size in *SIZE.  Return NULL if there are
+   no entries.  */
+static struct cache_soname_index *
+build_soname_index (uint32_t *size)
+{
+  /* Count the distinct keys.  Entries with the same key are adjacent
+     because the list is sorted.  */
+  uint32_t nkeys = 0;
+  for (struct cache_entry *e = entries, *prev = NULL; e != NULL;
+       prev = e, e = e->next)
+    if (prev == NULL || _dl_cache_libcmp (prev->lib->string,
+					  e->lib->string) != 0)
+      ++nkeys;
+
+  *size = 0;
+  if (nkeys == 0)
+    return NULL;
+
+  /* Keep the table at most half full.  */
+  uint32_t nslots = 8;
+  while (nslots < 2 * nkeys)
+    nslots *= 2;
+
+  *size = (sizeof (struct cache_soname_index)
+	   + nslots * sizeof (struct cache_soname_index_slot));
+  struct cache_soname_index *index = xcalloc (1, *size);
+  index->nslots = nslots;
+
+  uint32_t idx = 0;
+  for (struct cache_entry *e = entries, *prev = NULL; e != NULL;
+       prev = e, e = e->next, ++idx)
+    if (prev == NULL || _dl_cache_libcmp (prev->lib->string,
+					  e->lib->string) != 0)
+      {
+	uint32_t hash = _dl_cache_soname_hash (e->lib->string);
+	uint32_t i = hash & (nslots - 1);
+	while (index->slots[i].entry != 0)
+	  i = (i + 1) & (nslots - 1);
+	index->slots[i].hash = hash;
+	index->slots[i].entry = idx + 1;
+      }
+
+  return index;
+}
+
 /* Write the cache extensions to FD.  The string table is shifted by
    STRING_TABLE_OFFSET.  The extension directory is assumed to be
    located at CACHE_EXTENSION_OFFSET.  assign_glibc_hwcaps_indices
@@ -497,22 +543,25 @@ write_extensions (int fd, uint32_t str_offset,
 
   /* The length and contents of the glibc-hwcaps section.  */
   uint32_t hwcaps_count = glibc_hwcaps_count ();
-  uint32_t hwcaps_offset = cache_extension_offset + cache_extension_size;
   uint32_t hwcaps_size = hwcaps_count * sizeof (uint32_t);
   uint32_t *hwcaps_array = xmalloc (hwcaps_size);
   for (struct glibc_hwcaps_subdirectory *p = hwcaps; p != NULL; p = p->next)
     if (p->used)
       hwcaps_array[p->section_index] = str_offset + p->name->offset;
 
-  /* This is the offset of the generator string.  */
-  uint32_t generator_offset = hwcaps_offset;
-  if (hwcaps_count == 0)
-    /* There is no section for the hwcaps subdirectories.  */
-    generator_offset -= sizeof (struct cache_extension_section);
-  else
-    /* The string table indices for the hwcaps subdirectories shift
-       the generator string backwards.  */
-    generator_offset += hwcaps_size;
+  /* The hash table over the cache entries.  */
+  uint32_t index_size;
+  struct cache_soname_index *index = build_soname_index (&index_size);
+
+  /* The sections which require 4-byte alignment come first, directly
+     after the extension directory.  The generator string is last.  */
+  uint32_t section_count = 1 + (hwcaps_count > 0) + (index != NULL);
+  uint32_t hwcaps_offset = (cache_extension_offset
+			    + offsetof (struct cache_extension, sections)
+			    + (section_count
+			       * sizeof (struct cache_extension_section)));
+  uint32_t index_offset = hwcaps_offset + hwcaps_size;
+  uint32_t generator_offset = index_offset + index_size;
 
   struct cache_extension *ext = xmalloc (cache_extension_size);
   ext->magic = cache_extension_magic;
@@ -536,17 +585,28 @@ write_extensions (int fd, uint32_t str_offset,
       ext->sections[xid].size = hwcaps_size;
     }
 
+  if (index != NULL)
+    {
+      ++xid;
+      ext->sections[xid].tag = cache_extension_tag_soname_index;
+      ext->sections[xid].flags = 0;
+      ext->sections[xid].offset = index_offset;
+      ext->sections[xid].size = index_size;
+    }
+
   ++xid;
   ext->count = xid;
-  assert (xid <= cache_extension_count);
+  assert (xid == section_count);
 
   size_t ext_size = (offsetof (struct cache_extension, sections)
 		     + xid * sizeof (struct cache_extension_section));
   if (write (fd, ext, ext_size) != ext_size
       || write (fd, hwcaps_array, hwcaps_size) != hwcaps_size
+      || write (fd, index, index_size) != index_size
       || write (fd, generator, strlen (generator)) != strlen (generator))
     error (EXIT_FAILURE, errno, _("Writing of cache extension data failed"));
 
+  free (index);
   free (ext);
 }
 
@@ -36,6 +36,10 @@ static struct cache_file *cache;
 static struct cache_file_new *cache_new;
 static size_t cachesize;
 
+/* The hash table over the entries of cache_new, or NULL if the cache
+   does not have one.  */
+static const struct cache_soname_index *cache_index;
+
 #ifdef SHARED
 /* This is used to cache the priorities of glibc-hwcaps
    subdirectories.  The elements of _dl_cache_priorities correspond to
@@ -191,31 +195,51 @@ _dl_cache_file_entry (const struct file_entry *libs, size_t entry_size,
   return (const void *) libs + index * entry_size;
 }
 
-/* We use binary search since the table is sorted in the cache file.
-   The first matching entry in the table is returned.  It is important
-   to use the same algorithm as used while generating the cache file.
-   STRING_TABLE_SIZE indicates the maximum offset in STRING_TABLE at
-   which data is mapped; it is not exact.  */
-static const char *
-search_cache (const char *string_table, uint32_t string_table_size,
-	      struct file_entry *libs, uint32_t nlibs, uint32_t entry_size,
-	      const char *name)
+/* Return the index of the first entry in LIBS whose key matches NAME,
+   using the hash table INDEX, or -1 if there is no such entry.  */
+static int
+search_cache_index (const struct cache_soname_index *index,
+		    const char *string_table, uint32_t string_table_size,
+		    struct file_entry *libs, uint32_t nlibs,
+		    uint32_t entry_size, const char *name)
 {
-  /* Used by the HWCAP check in the struct file_entry_new case.  */
-  uint64_t platform = _dl_string_platform (GLRO (dl_platform));
-  if (platform != (uint64_t) -1)
-    platform = 1ULL << platform;
-  uint64_t hwcap_mask = GET_HWCAP_MASK ();
-#define _DL_HWCAP_TLS_MASK (1LL << 63)
-  uint64_t hwcap_exclude = ~((GLRO (dl_hwcap) & hwcap_mask)
-			     | _DL_HWCAP_PLATFORM | _DL_HWCAP_TLS_MASK);
+  uint32_t hash = _dl_cache_soname_hash (name);
+  uint32_t mask = index->nslots - 1;
+
+  for (uint32_t i = 0; i <= mask; ++i)
+    {
+      const struct cache_soname_index_slot *slot
+	= &index->slots[(hash + i) & mask];
+      if (slot->entry == 0)
+	/* An empty slot ends the probe sequence.  */
+	break;
+      if (slot->hash == hash && slot->entry <= nlibs)
+	{
+	  uint32_t key
+	    = _dl_cache_file_entry (libs, entry_size, slot->entry - 1)->key;
+	  /* Make sure string table indices are not bogus before using
+	     them.  */
+	  if (!_dl_cache_verify_ptr (key, string_table_size))
+	    break;
+	  if (_dl_cache_libcmp (name, string_table + key) == 0)
+	    return slot->entry - 1;
+	}
+    }
 
+  return -1;
+}
+
+/* We use binary search since the table is sorted in the cache file.
+   Return the index of the first matching entry in the table, or -1 if
+   there is none.  It is important to use the same algorithm as used
+   while generating the cache file.  */
+static int
+search_cache_bisect (const char *string_table, uint32_t string_table_size,
+		     struct file_entry *libs, uint32_t nlibs,
+		     uint32_t entry_size, const char *name)
+{
   int left = 0;
   int right = nlibs - 1;
-  const char *best = NULL;
-#ifdef SHARED
-  uint32_t best_priority = 0;
-#endif
 
   while (left <= right)
     {
@@ -225,16 +249,12 @@ search_cache (const char *string_table, uint32_t string_table_size,
       /* Make sure string table indices are not bogus before using
 	 them.  */
       if (!_dl_cache_verify_ptr (key, string_table_size))
-	return NULL;
+	return -1;
 
       /* Actually compare the entry with the key.  */
       int cmpres = _dl_cache_libcmp (name, string_table + key);
       if (__glibc_unlikely (cmpres == 0))
 	{
-	  /* Found it.  LEFT now marks the last entry for which we
-	     know the name is correct.  */
-	  left = middle;
-
 	  /* There might be entries with this name before the one we
 	     found.  So we have to find the beginning.  */
 	  while (middle > 0)
@@ -248,113 +268,154 @@ search_cache (const char *string_table, uint32_t string_table_size,
 		break;
 	      --middle;
 	    }
+	  return middle;
+	}
+
+      if (cmpres < 0)
+	left = middle + 1;
+      else
+	right = middle - 1;
+    }
+
+  return -1;
+}
+
+/* Return the best entry for NAME in the cache, or NULL if there is
+   none.  The first matching entry is located with the hash table INDEX
+   if there is one, and by binary search otherwise.
+   STRING_TABLE_SIZE indicates the maximum offset in STRING_TABLE at
+   which data is mapped; it is not exact.  */
+static const char *
+search_cache (const char *string_table, uint32_t string_table_size,
+	      struct file_entry *libs, uint32_t nlibs, uint32_t entry_size,
+	      const struct cache_soname_index *index, const char *name)
+{
+  /* Used by the HWCAP check in the struct file_entry_new case.  */
+  uint64_t platform = _dl_string_platform (GLRO (dl_platform));
+  if (platform != (uint64_t) -1)
+    platform = 1ULL << platform;
+  uint64_t hwcap_mask = GET_HWCAP_MASK ();
+#define _DL_HWCAP_TLS_MASK (1LL << 63)
+  uint64_t hwcap_exclude = ~((GLRO (dl_hwcap) & hwcap_mask)
+			     | _DL_HWCAP_PLATFORM | _DL_HWCAP_TLS_MASK);
+
+  int left;
+  if (index != NULL)
+    left = search_cache_index (index, string_table, string_table_size,
+			       libs, nlibs, entry_size, name);
+  else
+    left = search_cache_bisect (string_table, string_table_size,
+				libs, nlibs, entry_size, name);
+  if (left < 0)
+    return NULL;
 
-	  do
+  /* LEFT now marks the first entry for which we know the name is
+     correct.  */
+  int middle = left;
+  int right = nlibs - 1;
+  const char *best = NULL;
+#ifdef SHARED
+  uint32_t best_priority = 0;
+#endif
+
+  do
+    {
+      int flags;
+      const struct file_entry *lib
+	= _dl_cache_file_entry (libs, entry_size, middle);
+
+      /* Only perform the name test if necessary.  */
+      if (middle > left
+	  /* We haven't seen this string so far.  Test whether the
+	     index is ok and whether the name matches.  Otherwise
+	     we are done.  */
+	  && (! _dl_cache_verify_ptr (lib->key, string_table_size)
+	      || (_dl_cache_libcmp (name, string_table + lib->key)
+		  != 0)))
+	break;
+
+      flags = lib->flags;
+      if (_dl_cache_check_flags (flags)
+	  && _dl_cache_verify_ptr (lib->value, string_table_size))
+	{
+	  if (best == NULL || flags == GLRO (dl_correct_cache_id))
 	    {
-	      int flags;
-	      const struct file_entry *lib
-		= _dl_cache_file_entry (libs, entry_size, middle);
-
-	      /* Only perform the name test if necessary.  */
-	      if (middle > left
-		  /* We haven't seen this string so far.  Test whether the
-		     index is ok and whether the name matches.  Otherwise
-		     we are done.  */
-		  && (! _dl_cache_verify_ptr (lib->key, string_table_size)
-		      || (_dl_cache_libcmp (name, string_table + lib->key)
-			  != 0)))
-		break;
+	      /* Named/extension hwcaps get slightly different
+		 treatment: We keep searching for a better
+		 match.  */
+	      bool named_hwcap = false;
 
-	      flags = lib->flags;
-	      if (_dl_cache_check_flags (flags)
-		  && _dl_cache_verify_ptr (lib->value, string_table_size))
+	      if (entry_size >= sizeof (struct file_entry_new))
 		{
-		  if (best == NULL || flags == GLRO (dl_correct_cache_id))
-		    {
-		      /* Named/extension hwcaps get slightly different
-			 treatment: We keep searching for a better
-			 match.  */
-		      bool named_hwcap = false;
-
-		      if (entry_size >= sizeof (struct file_entry_new))
-			{
-			  /* The entry is large enough to include
-			     HWCAP data.  Check it.  */
-			  struct file_entry_new *libnew
-			    = (struct file_entry_new *) lib;
+		  /* The entry is large enough to include
+		     HWCAP data.  Check it.  */
+		  struct file_entry_new *libnew
+		    = (struct file_entry_new *) lib;
 
 #ifdef SHARED
-			  named_hwcap = dl_cache_hwcap_extension (libnew);
-			  if (named_hwcap
-			      && !dl_cache_hwcap_isa_level_compatible (libnew))
-			    continue;
+		  named_hwcap = dl_cache_hwcap_extension (libnew);
+		  if (named_hwcap
+		      && !dl_cache_hwcap_isa_level_compatible (libnew))
+		    continue;
 #endif
 
-			  /* The entries with named/extension hwcaps
-			     have been exhausted.  Return the best
-			     match encountered so far if there is
-			     one.  */
-			  if (!named_hwcap && best != NULL)
-			    break;
-
-			  if ((libnew->hwcap & hwcap_exclude) && !named_hwcap)
-			    continue;
-			  if (GLRO (dl_osversion)
-			      && libnew->osversion > GLRO (dl_osversion))
-			    continue;
-			  if (_DL_PLATFORMS_COUNT
-			      && (libnew->hwcap & _DL_HWCAP_PLATFORM) != 0
-			      && ((libnew->hwcap & _DL_HWCAP_PLATFORM)
-				  != platform))
-			    continue;
+		  /* The entries with named/extension hwcaps
+		     have been exhausted.  Return the best
+		     match encountered so far if there is
+		     one.  */
+		  if (!named_hwcap && best != NULL)
+		    break;
+
+		  if ((libnew->hwcap & hwcap_exclude) && !named_hwcap)
+		    continue;
+		  if (GLRO (dl_osversion)
+		      && libnew->osversion > GLRO (dl_osversion))
+		    continue;
+		  if (_DL_PLATFORMS_COUNT
+		      && (libnew->hwcap & _DL_HWCAP_PLATFORM) != 0
+		      && ((libnew->hwcap & _DL_HWCAP_PLATFORM)
+			  != platform))
+		    continue;
 
 #ifdef SHARED
-			  /* For named hwcaps, determine the priority
-			     and see if beats what has been found so
-			     far.  */
-			  if (named_hwcap)
-			    {
-			      uint32_t entry_priority
-				= glibc_hwcaps_priority (libnew->hwcap);
-			      if (entry_priority == 0)
-				/* Not usable at all.  Skip.  */
-				continue;
-			      else if (best == NULL
-				       || entry_priority < best_priority)
-				/* This entry is of higher priority
-				   than the previous one, or it is the
-				   first entry.  */
-				best_priority = entry_priority;
-			      else
-				/* An entry has already been found,
-				   but it is a better match.  */
-				continue;
-			    }
-#endif /* SHARED */
-			}
-
-		      best = string_table + lib->value;
-
-		      if (flags == GLRO (dl_correct_cache_id)
-			  && !named_hwcap)
-			/* We've found an exact match for the shared
-			   object and no general `ELF' release.  Stop
-			   searching, but not if a named (extension)
-			   hwcap is used.  In this case, an entry with
-			   a higher priority may come up later.  */
-			break;
+		  /* For named hwcaps, determine the priority
+		     and see if beats what has been found so
+		     far.  */
+		  if (named_hwcap)
+		    {
+		      uint32_t entry_priority
+			= glibc_hwcaps_priority (libnew->hwcap);
+		      if (entry_priority == 0)
+			/* Not usable at all.  Skip.  */
+			continue;
+		      else if (best == NULL
+			       || entry_priority < best_priority)
+			/* This entry is of higher priority
+			   than the previous one, or it is the
+			   first entry.  */
+			best_priority = entry_priority;
+		      else
+			/* An entry has already been found,
+			   but it is a better match.  */
+			continue;
 		    }
+#endif /* SHARED */
 		}
+
+	      best = string_table + lib->value;
+
+	      if (flags == GLRO (dl_correct_cache_id)
+		  && !named_hwcap)
+		/* We've found an exact match for the shared
+		   object and no general `ELF' release.  Stop
+		   searching, but not if a named (extension)
+		   hwcap is used.  In this case, an entry with
+		   a higher priority may come up later.  */
+		break;
 	    }
-	  while (++middle <= right);
-	  break;
 	}
-
-      if (cmpres < 0)
-	left = middle + 1;
-      else
-	right = middle - 1;
     }
+  while (++middle <= right);
 
   return best;
 }
@@ -479,6 +540,15 @@ _dl_load_cache_lookup (const char *name)
 	}
 
       assert (cache != NULL);
+
+      cache_index = NULL;
+      if (cache_new != (void *) -1)
+	{
+	  struct cache_extension_all_loaded ext;
+	  if (cache_extension_load (cache_new, cache, cachesize, &ext))
+	    cache_index
+	      = ext.sections[cache_extension_tag_soname_index].base;
+	}
     }
 
   if (cache == (void *) -1)
@@ -491,7 +561,7 @@ _dl_load_cache_lookup (const char *name)
       const char *string_table = (const char *) cache_new;
       best = search_cache (string_table, cachesize,
 			   &cache_new->libs[0].entry, cache_new->nlibs,
-			   sizeof (cache_new->libs[0]), name);
+			   sizeof (cache_new->libs[0]), cache_index, name);
     }
   else
     {
@@ -500,7 +570,7 @@ _dl_load_cache_lookup (const char *name)
 	= (const char *) cache + cachesize - string_table;
       best = search_cache (string_table, string_table_size,
 			   &cache->libs[0], cache->nlibs,
-			   sizeof (cache->libs[0]), name);
+			   sizeof (cache->libs[0]), NULL, name);
     }
 
   /* Print our result if wanted.  */
@@ -0,0 +1,368 @@
+/* Locating objects by address without taking locks.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <assert.h>
+#include <atomic.h>
+#include <dlfcn.h>
+#include <ldsodefs.h>
+#include <libc-pointer-arith.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* The address ranges of all loaded objects are kept in an array sorted
+   by start address, so that an address can be looked up with a binary
+   search.  There are two such arrays.  Readers use the one selected by
+   the low bit of _dlfo_version, and the writer (which holds
+   GL(dl_load_lock)) rebuilds the other one and then increments the
+   version to switch to it.  A reader which observes a version change
+   during its lookup may have seen a partially rewritten array and
+   retries.
+
+   Arrays which are replaced by larger ones are not freed because
+   readers may still be accessing them.  The arrays grow geometrically,
+   so the memory lost this way is bounded by the size of the largest
+   array.  */
+
+/* Information about one loaded object.  */
+struct dlfo_mapping
+{
+  uintptr_t map_start;
+  uintptr_t map_end;
+  struct link_map *map;
+  void *eh_frame;
+};
+
+struct dlfo_mappings
+{
+  /* Number of elements in the objects array.  Does not change after
+     allocation.  */
+  size_t allocated;
+
+  /* Number of elements currently in use.  */
+  size_t size;
+
+  struct dlfo_mapping objects[];
+};
+
+/* The two arrays.  _dlfo_mappings[_dlfo_version & 1] is active.  */
+static struct dlfo_mappings *_dlfo_mappings[2];
+
+/* Incremented whenever the active array changes.  */
+static unsigned int _dlfo_version;
+
+/* The value of GL(dl_load_adds) at the last update.  If it is still
+   current, an address which is not found in the active array does not
+   belong to any loaded object.  */
+static unsigned long long int _dlfo_load_adds;
+
+#ifndef SHARED
+/* The main program of a static executable does not have a proper
+   link map, so it is not part of the arrays.  */
+static struct dlfo_mapping _dlfo_main;
+#endif
+
+/* Fill in *RESULT with the entry in the active array whose address
+   range contains PC.  Return false if there is no such entry.  */
+static bool
+_dlfo_lookup (uintptr_t pc, struct dlfo_mapping *result)
+{
+  while (true)
+    {
+      unsigned int start_version = atomic_load_acquire (&_dlfo_version);
+      struct dlfo_mappings *mappings
+	= atomic_load_relaxed (&_dlfo_mappings[start_version & 1]);
+      if (mappings == NULL)
+	return false;
+
+      /* SIZE may be torn by a concurrent update, in which case the
+	 version check below fails.  Keep the search within the
+	 array.  */
+      size_t size = mappings->size;
+      if (size > mappings->allocated)
+	size = mappings->allocated;
+
+      /* Find the first entry which starts after PC.  */
+      size_t left = 0;
+      size_t right = size;
+      while (left < right)
+	{
+	  size_t middle = left + (right - left) / 2;
+	  if (mappings->objects[middle].map_start <= pc)
+	    left = middle + 1;
+	  else
+	    right = middle;
+	}
+
+      bool found = false;
+      if (left > 0)
+	{
+	  *result = mappings->objects[left - 1];
+	  found = pc < result->map_end;
+	}
+
+      /* Make sure that the reads above happen before the version is
+	 checked again.  */
+      atomic_thread_fence_acquire ();
+      if (atomic_load_relaxed (&_dlfo_version) == start_version)
+	return found;
+    }
+}
+
+int
+_dl_find_object (void *pc1, struct dl_find_object *result)
+{
+  uintptr_t pc = (uintptr_t) pc1;
+  struct dlfo_mapping mapping;
+
+#ifndef SHARED
+  if (pc >= _dlfo_main.map_start && pc < _dlfo_main.map_end)
+    mapping = _dlfo_main;
+  else
+#endif
+  if (!_dlfo_lookup (pc, &mapping))
+    return -1;
+
+  result->dlfo_flags = 0;
+  result->dlfo_map_start = (void *) mapping.map_start;
+  result->dlfo_map_end = (void *) mapping.map_end;
+  result->dlfo_link_map = mapping.map;
+  result->dlfo_eh_frame = mapping.eh_frame;
+  return 0;
+}
+rtld_hidden_def (_dl_find_object)
+
+/* Search link maps in all namespaces for the DSO that contains the object at
+   address ADDR.  Returns the pointer to the link map of the matching DSO, or
+   NULL if a match is not found.  */
+struct link_map *
+_dl_find_dso_for_object (const ElfW(Addr) addr)
+{
+  struct dlfo_mapping mapping;
+  if (_dlfo_lookup (addr, &mapping))
+    {
+      struct link_map *l = mapping.map;
+      if (l->l_contiguous || _dl_addr_inside_object (l, addr))
+	return l;
+      return NULL;
+    }
+
+  /* Objects which are being loaded are not in the array yet.  The
+     caller holds GL(dl_load_lock) or GL(dl_load_write_lock), so the
+     lists can be searched.  */
+  if (_dlfo_load_adds == GL(dl_load_adds))
+    return NULL;
+
+  for (Lmid_t ns = 0; ns < GL(dl_nns); ++ns)
+    for (struct link_map *l = GL(dl_ns)[ns]._ns_loaded; l != NULL;
+	 l = l->l_next)
+      if (addr >= l->l_map_start && addr < l->l_map_end
+	  && (l->l_contiguous
+	      || _dl_addr_inside_object (l, (ElfW(Addr)) addr)))
+	{
+	  assert (ns == l->l_ns);
+	  return l;
+	}
+  return NULL;
+}
+rtld_hidden_def (_dl_find_dso_for_object);
+
+/* Return true if L is to be put into the arrays.  Proxy maps for ld.so
+   in secondary namespaces have no address range of their own, and
+   objects which are being unloaded must be gone from the arrays before
+   they are unmapped.  */
+static bool
+_dlfo_include_p (const struct link_map *l)
+{
+  return (l->l_real == l
+	  && l->l_map_start < l->l_map_end
+	  && !l->l_removed);
+}
+
+/* Return the address of the PT_GNU_EH_FRAME segment of L, or NULL.  */
+static void *
+_dlfo_eh_frame (const struct link_map *l)
+{
+  for (const ElfW(Phdr) *ph = l->l_phdr; ph < &l->l_phdr[l->l_phnum]; ++ph)
+    if (ph->p_type == PT_GNU_EH_FRAME)
+      return (void *) (l->l_addr + ph->p_vaddr);
+  return NULL;
+}
+
+static struct dlfo_mappings *
+_dlfo_allocate (size_t count)
+{
+  /* Leave room for further objects, so that the arrays need not be
+     replaced on every dlopen.  */
+  size_t allocated = 2 * count;
+  if (allocated < 16)
+    allocated = 16;
+  struct dlfo_mappings *result
+    = malloc (sizeof (*result) + allocated * sizeof (result->objects[0]));
+  if (result != NULL)
+    {
+      result->allocated = allocated;
+      result->size = 0;
+    }
+  return result;
+}
+
+/* Sort the SIZE entries of OBJECTS by start address.  The address
+   ranges of different objects do not overlap.  Heapsort is used
+   because qsort is not available in ld.so.  */
+static void
+_dlfo_sort (struct dlfo_mapping *objects, size_t size)
+{
+  if (size < 2)
+    return;
+
+  size_t start = size / 2;
+  size_t end = size;
+  while (end > 1)
+    {
+      if (start > 0)
+	--start;
+      else
+	{
+	  --end;
+	  struct dlfo_mapping tmp = objects[end];
+	  objects[end] = objects[0];
+	  objects[0] = tmp;
+	}
+
+      /* Sift the element at START down the heap of END elements.  */
+      size_t root = start;
+      while (2 * root + 1 < end)
+	{
+	  size_t child = 2 * root + 1;
+	  if (child + 1 < end
+	      && objects[child].map_start < objects[child + 1].map_start)
+	    ++child;
+	  if (objects[root].map_start >= objects[child].map_start)
+	    break;
+	  struct dlfo_mapping tmp = objects[root];
+	  objects[root] = objects[child];
+	  objects[child] = tmp;
+	  root = child;
+	}
+    }
+}
+
+bool
+_dl_find_object_update (void)
+{
+  size_t count = 0;
+  for (Lmid_t ns = 0; ns < GL(dl_nns); ++ns)
+    for (struct link_map *l = GL(dl_ns)[ns]._ns_loaded; l != NULL;
+	 l = l->l_next)
+      count += _dlfo_include_p (l);
+
+  unsigned int version = _dlfo_version;
+  struct dlfo_mappings *active = _dlfo_mappings[version & 1];
+  struct dlfo_mappings *target = _dlfo_mappings[(version + 1) & 1];
+
+  /* Both arrays need room for COUNT objects, so that an update which
+     only removes objects (during dlclose) never needs to allocate.  */
+  bool new_target = target == NULL || target->allocated < count;
+  if (new_target)
+    {
+      target = _dlfo_allocate (count);
+      if (target == NULL)
+	return false;
+    }
+  struct dlfo_mappings *new_active = NULL;
+  if (active == NULL || active->allocated < count)
+    {
+      new_active = _dlfo_allocate (count);
+      if (new_active == NULL)
+	{
+	  if (new_target)
+	    free (target);
+	  return false;
+	}
+    }
+
+  /* Readers which started before the last version change may still be
+     looking at TARGET.  They must observe that change if they see any
+     of the writes below.  */
+  atomic_thread_fence_release ();
+
+  size_t i = 0;
+  for (Lmid_t ns = 0; ns < GL(dl_nns); ++ns)
+    for (struct link_map *l = GL(dl_ns)[ns]._ns_loaded; l != NULL;
+	 l = l->l_next)
+      if (_dlfo_include_p (l))
+	{
+	  target->objects[i].map_start = l->l_map_start;
+	  target->objects[i].map_end = l->l_map_end;
+	  target->objects[i].map = l;
+	  target->objects[i].eh_frame = _dlfo_eh_frame (l);
+	  ++i;
+	}
+  assert (i == count);
+  _dlfo_sort (target->objects, count);
+  target->size = count;
+
+  /* Switch readers to the new array.  */
+  atomic_store_relaxed (&_dlfo_mappings[(version + 1) & 1], target);
+  atomic_store_release (&_dlfo_version, version + 1);
+
+  /* The previously active array is now unused.  Its contents are
+     rewritten by the next update.  */
+  if (new_active != NULL)
+    atomic_store_relaxed (&_dlfo_mappings[version & 1], new_active);
+
+  _dlfo_load_adds = GL(dl_load_adds);
+  return true;
+}
+
+#ifndef SHARED
+void
+_dl_find_object_init (void)
+{
+  struct link_map *main_map = GL(dl_ns)[LM_ID_BASE]._ns_loaded;
+
+  /* Compute the address range of the main program from its program
+     headers.  */
+  uintptr_t start = UINTPTR_MAX;
+  uintptr_t end = 0;
+  for (const ElfW(Phdr) *ph = _dl_phdr; ph < &_dl_phdr[_dl_phnum]; ++ph)
+    if (ph->p_type == PT_LOAD)
+      {
+	uintptr_t seg_start = ALIGN_DOWN (ph->p_vaddr, GLRO(dl_pagesize));
+	uintptr_t seg_end = ph->p_vaddr + ph->p_memsz;
+	if (seg_start < start)
+	  start = seg_start;
+	if (seg_end > end)
+	  end = seg_end;
+      }
+    else if (ph->p_type == PT_GNU_EH_FRAME)
+      _dlfo_main.eh_frame = (void *) (main_map->l_addr + ph->p_vaddr);
+
+  if (start < end)
+    {
+      _dlfo_main.map_start = main_map->l_addr + start;
+      _dlfo_main.map_end = main_map->l_addr + end;
+      _dlfo_main.map = main_map;
+    }
+
+  if (!_dl_find_object_update ())
+    _dl_fatal_printf ("Fatal glibc error: cannot allocate memory for"
+		      " the object address table\n");
+}
+#endif
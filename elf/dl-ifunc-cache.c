@@ -0,0 +1,434 @@
+/* Cache of IFUNC resolver results across processes.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <_itoa.h>
+#include <array_length.h>
+#include <dl-ifunc-cache.h>
+#include <dl-ifunc-cpu.h>
+#include <fcntl.h>
+#include <libc-pointer-arith.h>
+#include <not-cancel.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define TUNABLE_NAMESPACE rtld
+#include <dl-tunables.h>
+
+/* If the glibc.rtld.ifunc_cache tunable is set, the results of the
+   IFUNC resolvers called while relocating the initial objects are
+   stored in the file it names, keyed by the build ID of the object
+   which defines the resolver and by the CPU data which the resolvers
+   of the system use (see dl-ifunc-cpu.h).  Later processes which find
+   a result in the file use it instead of calling the resolver.  This
+   assumes that resolvers do not depend on anything else, which holds
+   for the resolvers in glibc.
+
+   The file consists of a header followed by the entries, sorted by
+   object key and resolver offset.  Offsets are relative to the load
+   address of the object.  The file is only used if it is owned by the
+   effective user and not writable by anyone else.  It is replaced
+   with rename, so concurrent readers always see a complete file.  */
+
+#define IFUNC_CACHE_MAGIC "ld.ifc1"
+
+struct ifunc_cache_header
+{
+  char magic[sizeof (IFUNC_CACHE_MAGIC)];
+  uint64_t cpu_key;
+  uint64_t count;
+};
+
+struct ifunc_cache_entry
+{
+  uint64_t object;
+  uint64_t resolver;
+  uint64_t result;
+};
+
+/* Results obtained during startup which are not in the file yet.  */
+struct ifunc_cache_chunk
+{
+  struct ifunc_cache_chunk *next;
+  size_t used;
+  struct ifunc_cache_entry entries[64];
+};
+
+bool _dl_ifunc_cache_active;
+
+static const char *cache_path;
+static uint64_t cache_cpu_key;
+static const struct ifunc_cache_entry *cache_entries;
+static size_t cache_count;
+static struct ifunc_cache_chunk *cache_new;
+static bool cache_recording;
+
+/* Object keys which are not a hash of a build ID.  */
+enum
+  {
+    object_key_unknown = 0,
+    object_key_none = 1,
+  };
+
+/* 64-bit FNV-1a.  */
+static uint64_t
+hash_bytes (uint64_t hash, const void *data, size_t size)
+{
+  const unsigned char *p = data;
+  for (size_t i = 0; i < size; ++i)
+    {
+      hash ^= p[i];
+      hash *= 0x100000001b3ULL;
+    }
+  return hash;
+}
+
+#define HASH_INIT 0xcbf29ce484222325ULL
+
+/* Compute the key of L from its NT_GNU_BUILD_ID note.  */
+static uint64_t
+compute_object_key (const struct link_map *l)
+{
+  for (const ElfW(Phdr) *ph = l->l_phdr; ph < &l->l_phdr[l->l_phnum]; ++ph)
+    {
+      if (ph->p_type != PT_NOTE)
+	continue;
+      size_t align = ph->p_align == 8 ? 8 : 4;
+      ElfW(Addr) start = l->l_addr + ph->p_vaddr;
+      ElfW(Addr) end = start + ph->p_memsz;
+      while (end - start >= sizeof (ElfW(Nhdr)))
+	{
+	  const ElfW(Nhdr) *note = (const ElfW(Nhdr) *) start;
+	  ElfW(Addr) name = start + sizeof (*note);
+	  ElfW(Addr) desc = ALIGN_UP (name + note->n_namesz, align);
+	  ElfW(Addr) next = ALIGN_UP (desc + note->n_descsz, align);
+	  if (next > end || next <= start)
+	    break;
+	  if (note->n_type == NT_GNU_BUILD_ID && note->n_namesz == 4
+	      && memcmp ((const void *) name, "GNU", 4) == 0
+	      && note->n_descsz > 0)
+	    {
+	      uint64_t key = hash_bytes (HASH_INIT, (const void *) desc,
+					 note->n_descsz);
+	      if (key == object_key_unknown || key == object_key_none)
+		key += 2;
+	      return key;
+	    }
+	  start = next;
+	}
+    }
+  return object_key_none;
+}
+
+static uint64_t
+object_key (struct link_map *l)
+{
+  if (l->l_ifunc_cache_key == object_key_unknown)
+    l->l_ifunc_cache_key = compute_object_key (l);
+  return l->l_ifunc_cache_key;
+}
+
+/* Return a negative, zero, or positive value if A sorts before, equal
+   to, or after B.  Results are not compared.  */
+static int
+compare_entries (const struct ifunc_cache_entry *a,
+		 const struct ifunc_cache_entry *b)
+{
+  if (a->object != b->object)
+    return a->object < b->object ? -1 : 1;
+  if (a->resolver != b->resolver)
+    return a->resolver < b->resolver ? -1 : 1;
+  return 0;
+}
+
+/* Return the entry in the file which matches KEY, or NULL.  */
+static const struct ifunc_cache_entry *
+find_entry (const struct ifunc_cache_entry *key)
+{
+  size_t left = 0;
+  size_t right = cache_count;
+  while (left < right)
+    {
+      size_t middle = left + (right - left) / 2;
+      int cmp = compare_entries (&cache_entries[middle], key);
+      if (cmp == 0)
+	return &cache_entries[middle];
+      if (cmp < 0)
+	left = middle + 1;
+      else
+	right = middle;
+    }
+  return NULL;
+}
+
+/* Return true if KEY is among the new results.  */
+static bool
+find_new_entry (const struct ifunc_cache_entry *key)
+{
+  for (struct ifunc_cache_chunk *c = cache_new; c != NULL; c = c->next)
+    for (size_t i = 0; i < c->used; ++i)
+      if (compare_entries (&c->entries[i], key) == 0)
+	return true;
+  return false;
+}
+
+static void
+record_entry (const struct ifunc_cache_entry *entry)
+{
+  if (find_new_entry (entry))
+    return;
+  if (cache_new == NULL || cache_new->used == array_length (cache_new->entries))
+    {
+      /* If the allocation fails, the result is not cached.  */
+      struct ifunc_cache_chunk *c = malloc (sizeof (*c));
+      if (c == NULL)
+	return;
+      c->next = cache_new;
+      c->used = 0;
+      cache_new = c;
+    }
+  cache_new->entries[cache_new->used++] = *entry;
+}
+
+void
+_dl_ifunc_cache_init (void)
+{
+#if HAVE_TUNABLES
+  const char *path = TUNABLE_GET (ifunc_cache, const char *, NULL);
+  if (path == NULL || *path == '\0')
+    return;
+
+  const void *data;
+  size_t size;
+  if (!_dl_ifunc_cpu_data (&data, &size))
+    return;
+  cache_cpu_key = hash_bytes (HASH_INIT, data, size);
+  cache_path = path;
+  cache_recording = true;
+  _dl_ifunc_cache_active = true;
+
+  int fd = __open64_nocancel (path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+  if (fd < 0)
+    return;
+
+  struct stat64 st;
+  if (__fstat64 (fd, &st) == 0
+      && S_ISREG (st.st_mode)
+      && st.st_uid == __geteuid ()
+      && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0
+      && st.st_size >= sizeof (struct ifunc_cache_header))
+    {
+      void *file = __mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (file != MAP_FAILED)
+	{
+	  const struct ifunc_cache_header *header = file;
+	  size_t count = (st.st_size - sizeof (*header))
+			 / sizeof (struct ifunc_cache_entry);
+	  if (memcmp (header->magic, IFUNC_CACHE_MAGIC,
+		      sizeof (header->magic)) == 0
+	      && header->cpu_key == cache_cpu_key
+	      && header->count == count)
+	    {
+	      /* The file stays mapped, so that objects loaded by dlopen
+		 can use it, too.  */
+	      cache_entries = (const struct ifunc_cache_entry *) (header + 1);
+	      cache_count = count;
+	    }
+	  else
+	    __munmap (file, st.st_size);
+	}
+    }
+  __close_nocancel (fd);
+#endif /* HAVE_TUNABLES */
+}
+
+ElfW(Addr)
+_dl_ifunc_cache_resolve (struct link_map *map, struct link_map *resolver_map,
+			 ElfW(Addr) addr)
+{
+  struct ifunc_cache_entry key =
+    {
+      .object = object_key (resolver_map),
+      .resolver = addr - resolver_map->l_addr,
+    };
+  if (key.object == object_key_none)
+    return _dl_startup_profile_ifunc (map, addr);
+
+  const struct ifunc_cache_entry *entry = find_entry (&key);
+  if (entry != NULL)
+    {
+      ElfW(Addr) result = resolver_map->l_addr + entry->result;
+      /* A result outside the object means that the file does not
+	 match it after all.  */
+      if (result >= resolver_map->l_map_start
+	  && result < resolver_map->l_map_end)
+	return result;
+    }
+
+  ElfW(Addr) result = _dl_startup_profile_ifunc (map, addr);
+
+  /* Results which point to another object are not cached because that
+     object may be loaded at a different address relative to
+     RESOLVER_MAP in other processes.  */
+  if (cache_recording
+      && result >= resolver_map->l_map_start
+      && result < resolver_map->l_map_end)
+    {
+      key.result = result - resolver_map->l_addr;
+      record_entry (&key);
+    }
+  return result;
+}
+
+/* Merge the sorted arrays OLD and NEW and write the result to FD.
+   Entries in NEW replace those in OLD with the same key.  Return false
+   on error.  */
+static bool
+write_entries (int fd, const struct ifunc_cache_entry *old, size_t old_count,
+	       const struct ifunc_cache_entry *new, size_t new_count)
+{
+  struct ifunc_cache_entry buf[64];
+  size_t used = 0;
+  while (old_count > 0 || new_count > 0)
+    {
+      int cmp;
+      if (old_count == 0)
+	cmp = 1;
+      else if (new_count == 0)
+	cmp = -1;
+      else
+	cmp = compare_entries (old, new);
+      if (cmp < 0)
+	{
+	  buf[used++] = *old++;
+	  --old_count;
+	}
+      else
+	{
+	  if (cmp == 0)
+	    {
+	      ++old;
+	      --old_count;
+	    }
+	  buf[used++] = *new++;
+	  --new_count;
+	}
+      if (used == array_length (buf) || (old_count == 0 && new_count == 0))
+	{
+	  size_t size = used * sizeof (buf[0]);
+	  if (__write_nocancel (fd, buf, size) != size)
+	    return false;
+	  used = 0;
+	}
+    }
+  return true;
+}
+
+/* Sort the COUNT entries in ENTRIES.  The number of new entries is
+   small, so insertion sort is sufficient.  */
+static void
+sort_entries (struct ifunc_cache_entry *entries, size_t count)
+{
+  for (size_t i = 1; i < count; ++i)
+    {
+      struct ifunc_cache_entry tmp = entries[i];
+      size_t j = i;
+      while (j > 0 && compare_entries (&entries[j - 1], &tmp) > 0)
+	{
+	  entries[j] = entries[j - 1];
+	  --j;
+	}
+      entries[j] = tmp;
+    }
+}
+
+void
+_dl_ifunc_cache_write (void)
+{
+  if (!cache_recording)
+    return;
+  cache_recording = false;
+
+  size_t new_count = 0;
+  for (struct ifunc_cache_chunk *c = cache_new; c != NULL; c = c->next)
+    new_count += c->used;
+  if (new_count == 0)
+    return;
+
+  struct ifunc_cache_entry *new = malloc (new_count * sizeof (*new));
+  if (new != NULL)
+    {
+      size_t i = 0;
+      for (struct ifunc_cache_chunk *c = cache_new; c != NULL; c = c->next)
+	{
+	  memcpy (&new[i], c->entries, c->used * sizeof (c->entries[0]));
+	  i += c->used;
+	}
+      sort_entries (new, new_count);
+
+      /* Duplicates were removed by record_entry, so the entries in NEW
+	 which are also in the file only replace them.  */
+      size_t count = cache_count + new_count;
+      for (i = 0; i < new_count; ++i)
+	count -= find_entry (&new[i]) != NULL;
+
+      /* Write the file under a temporary name and move it into place.
+	 The name is unique among the processes of the system which use
+	 the same cache file.  */
+      size_t path_len = strlen (cache_path);
+      char tmp[path_len + 3 * sizeof (pid_t) + 6];
+      char *p = __mempcpy (tmp, cache_path, path_len);
+      *p++ = '.';
+      char pid[3 * sizeof (pid_t) + 1];
+      char *pid_end = &pid[sizeof (pid) - 1];
+      *pid_end = '\0';
+      char *pid_start = _itoa (__getpid (), pid_end, 10, 0);
+      p = __mempcpy (p, pid_start, pid_end - pid_start);
+      memcpy (p, ".tmp", sizeof (".tmp"));
+
+      int fd = __open64_nocancel (tmp, O_WRONLY | O_CREAT | O_EXCL
+				  | O_NOFOLLOW | O_CLOEXEC,
+				  S_IRUSR | S_IWUSR);
+      if (fd >= 0)
+	{
+	  struct ifunc_cache_header header =
+	    {
+	      .magic = IFUNC_CACHE_MAGIC,
+	      .cpu_key = cache_cpu_key,
+	      .count = count,
+	    };
+	  bool ok = (__write_nocancel (fd, &header, sizeof (header))
+		     == sizeof (header))
+		    && write_entries (fd, cache_entries, cache_count,
+				      new, new_count);
+	  __close_nocancel (fd);
+	  if (!ok || rename (tmp, cache_path) != 0)
+	    __unlink (tmp);
+	}
+      free (new);
+    }
+
+  /* Most of the chunks were allocated with the minimal malloc during
+     the initial relocation, and the real free must not see them.  Like
+     other startup allocations, they are never freed.  */
+  cache_new = NULL;
+}
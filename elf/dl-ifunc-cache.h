@@ -0,0 +1,59 @@
+/* Cache of IFUNC resolver results across processes.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _DL_IFUNC_CACHE_H
+#define _DL_IFUNC_CACHE_H
+
+#include <dl-startup-profile.h>
+#include <ldsodefs.h>
+#include <stdbool.h>
+
+#if IS_IN (rtld) && !defined RTLD_BOOTSTRAP
+/* True if the glibc.rtld.ifunc_cache tunable names a usable cache
+   file.  */
+extern bool _dl_ifunc_cache_active attribute_hidden;
+
+/* Load the cache file.  Called once the CPU features are known.  */
+extern void _dl_ifunc_cache_init (void) attribute_hidden;
+
+/* Return the result of the IFUNC resolver at ADDR in RESOLVER_MAP,
+   for a relocation in MAP, from the cache if possible.  */
+extern ElfW(Addr) _dl_ifunc_cache_resolve (struct link_map *map,
+					   struct link_map *resolver_map,
+					   ElfW(Addr) addr) attribute_hidden;
+
+/* Add the resolver results obtained during startup to the cache file
+   and stop recording new ones.  */
+extern void _dl_ifunc_cache_write (void) attribute_hidden;
+#endif
+
+/* Return the result of the IFUNC resolver at ADDR, which is defined in
+   RESOLVER_MAP, for a relocation in MAP.  */
+static inline ElfW(Addr)
+__attribute__ ((always_inline))
+_dl_ifunc_resolve (struct link_map *map, struct link_map *resolver_map,
+		   ElfW(Addr) addr)
+{
+#if IS_IN (rtld) && !defined RTLD_BOOTSTRAP
+  if (__glibc_unlikely (_dl_ifunc_cache_active))
+    return _dl_ifunc_cache_resolve (map, resolver_map, addr);
+#endif
+  return _dl_startup_profile_ifunc (map, addr);
+}
+
+#endif /* _DL_IFUNC_CACHE_H */
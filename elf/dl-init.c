@@ -20,6 +20,7 @@
 #include <stddef.h>
 #include <ldsodefs.h>
 #include <elf-initfini.h>
+#include <dl-startup-profile.h>
 
 
 static void
@@ -48,6 +49,11 @@ call_init (struct link_map *l, int argc, char **argv, char **env)
     _dl_debug_printf ("\ncalling init: %s\n\n",
 		      DSO_FILENAME (l->l_name));
 
+  struct dl_startup_profile *profile = _dl_startup_profile (l);
+  hp_timing_t profile_start = 0;
+  if (__glibc_unlikely (profile != NULL))
+    _dl_startup_profile_start (&profile_start);
+
   /* Now run the local constructors.  There are two forms of them:
      - the one named by DT_INIT
      - the others in the DT_INIT_ARRAY.
@@ -69,6 +75,9 @@ call_init (struct link_map *l, int argc, char **argv, char **env)
       for (j = 0; j < jm; ++j)
 	((dl_init_t) addrs[j]) (argc, argv, env);
     }
+
+  if (__glibc_unlikely (profile != NULL))
+    _dl_startup_profile_accum (&profile->init_time, profile_start);
 }
 
 
@@ -120,4 +129,11 @@ _dl_init (struct link_map *main_map, int argc, char **argv, char **env)
   /* Finished starting up.  */
   _dl_starting_up = 0;
 #endif
+
+#ifdef SHARED
+  /* The constructors of the initial objects have run.  */
+  if (__glibc_unlikely (GL(dl_startup_profile_output) != NULL)
+      && main_map == GL(dl_ns)[LM_ID_BASE]._ns_loaded)
+    _dl_startup_profile_write ();
+#endif
 }
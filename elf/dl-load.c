@@ -73,6 +73,7 @@ struct filebuf
 #include <dl-sysdep-open.h>
 #include <dl-prop.h>
 #include <not-cancel.h>
+#include <dl-startup-profile.h>
 
 #include <endian.h>
 #if BYTE_ORDER == BIG_ENDIAN
@@ -1178,6 +1179,7 @@ _dl_map_object_from_fd (const char *name, const char *origname, int fd,
 	  c->dataend = ph->p_vaddr + ph->p_filesz;
 	  c->allocend = ph->p_vaddr + ph->p_memsz;
 	  c->mapoff = ALIGN_DOWN (ph->p_offset, GLRO(dl_pagesize));
+	  c->mapalign = ph->p_align;
 
 	  /* Determine whether there is a gap between the last segment
 	     and this one.  */
@@ -2069,6 +2071,12 @@ _dl_map_object (struct link_map *loader, const char *name,
       return l;
     }
 
+#ifdef SHARED
+  hp_timing_t profile_start = 0;
+  if (__glibc_unlikely (GL(dl_startup_profile_output) != NULL))
+    _dl_startup_profile_start (&profile_start);
+#endif
+
   /* Display information if we are debugging.  */
   if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_FILES)
       && loader != NULL)
@@ -2334,8 +2342,20 @@ _dl_map_object (struct link_map *loader, const char *name,
     }
 
   void *stack_end = __libc_stack_end;
-  return _dl_map_object_from_fd (name, origname, fd, &fb, realname, loader,
-				 type, mode, &stack_end, nsid);
+  l = _dl_map_object_from_fd (name, origname, fd, &fb, realname, loader,
+			      type, mode, &stack_end, nsid);
+
+#ifdef SHARED
+  if (__glibc_unlikely (GL(dl_startup_profile_output) != NULL)
+      && l->l_startup_profile == NULL)
+    {
+      struct dl_startup_profile *profile = _dl_startup_profile_add (l);
+      if (profile != NULL)
+	_dl_startup_profile_accum (&profile->map_time, profile_start);
+    }
+#endif
+
+  return l;
 }
 
 struct add_path_state
@@ -21,8 +21,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/mman.h>
 #include <ldsodefs.h>
 #include <dl-hash.h>
+#include <dl-tunables.h>
+#include <poly-hash.h>
+#include <dl-startup-profile.h>
 #include <dl-machine.h>
 #include <sysdep-cancel.h>
 #include <libc-lock.h>
@@ -48,6 +52,18 @@ struct sym_val
 # define bump_num_relocations() ((void) 0)
 #endif
 
+/* Account a symbol lookup, or STEPS hash chain steps of one, to the
+   startup profile of UNDEF_MAP.  */
+#define profile_lookup(undef_map, member, steps)			      \
+  do									      \
+    {									      \
+      struct dl_startup_profile *__profile				      \
+	= (undef_map) != NULL ? _dl_startup_profile (undef_map) : NULL;	      \
+      if (__glibc_unlikely (__profile != NULL))				      \
+	__profile->member += (steps);					      \
+    }									      \
+  while (0)
+
 /* Utility function for do_lookup_x. The caller is called with undef_name,
    ref, version, flags and type_class, and those are passed as the first
    five arguments. The caller then computes sym, symidx, strtab, and map
@@ -349,6 +365,165 @@ marking %s [%lu] as NODELETE due to unique symbol\n",
   result->m = (struct link_map *) map;
 }
 
+#ifdef SHARED
+/* Do not bother with a summary for small scopes.  */
+# define SCOPE_SUMMARY_MIN_NLIST 16
+
+/* Limits for the number of buckets in a summary.  */
+# define SCOPE_SUMMARY_MIN_BUCKETS 64
+# define SCOPE_SUMMARY_MAX_BUCKETS (1U << 18)
+
+/* Call F (HASH, CLOSURE) for the GNU hash value of every symbol in the
+   hash table of MAP.  */
+static void
+scope_summary_foreach_hash (const struct link_map *map,
+			    void (*f) (uint32_t, void *), void *closure)
+{
+  for (Elf32_Word b = 0; b < map->l_nbuckets; ++b)
+    {
+      Elf32_Word bucket = map->l_gnu_buckets[b];
+      if (bucket == 0)
+	continue;
+      const Elf32_Word *hasharr = &map->l_gnu_chain_zero[bucket];
+      do
+	f (*hasharr, closure);
+      while ((*hasharr++ & 1u) == 0);
+    }
+}
+
+static void
+scope_summary_count (uint32_t hash, void *closure)
+{
+  ++*(size_t *) closure;
+}
+
+struct scope_summary_add_closure
+{
+  struct r_scope_summary *summary;
+  uint64_t bit;
+};
+
+static inline void
+scope_summary_buckets (const struct r_scope_summary *summary,
+		       uint32_t hash, uint32_t *b1, uint32_t *b2)
+{
+  /* The lowest bit of the hash values in the hash chains is used as
+     the end-of-chain marker.  */
+  hash >>= 1;
+  *b1 = hash & summary->mask;
+  *b2 = (hash >> summary->shift) & summary->mask;
+}
+
+static void
+scope_summary_add (uint32_t hash, void *closure)
+{
+  struct scope_summary_add_closure *c = closure;
+  uint32_t b1, b2;
+  scope_summary_buckets (c->summary, hash, &b1, &b2);
+  c->summary->buckets[b1] |= c->bit;
+  c->summary->buckets[b2] |= c->bit;
+}
+
+void
+_dl_scope_summary_init (struct link_map *main_map)
+{
+  /* Building the summary walks the hash chains of all objects, which
+     only pays off if the program performs many lookups.  */
+  int32_t enabled = 0;
+#if HAVE_TUNABLES
+  enabled = TUNABLE_GET_FULL (glibc, rtld, scope_summary, int32_t, NULL);
+#endif
+  if (enabled != 1)
+    return;
+
+  struct r_scope_elem *scope = &main_map->l_searchlist;
+  unsigned int nlist = scope->r_nlist;
+
+  /* The summary does not record which object a lookup was attempted
+     in, so keep the output of LD_DEBUG=symbols complete.  */
+  if (nlist < SCOPE_SUMMARY_MIN_NLIST
+      || (GLRO(dl_debug_mask) & DL_DEBUG_SYMBOLS))
+    return;
+
+  size_t nsyms = 0;
+  for (unsigned int i = 0; i < nlist; ++i)
+    {
+      const struct link_map *map = scope->r_list[i]->l_real;
+      if (map->l_gnu_bitmask != NULL)
+	scope_summary_foreach_hash (map, scope_summary_count, &nsyms);
+    }
+
+  /* With about one bucket for every two symbols, the bit of a given
+     group is set in only a few percent of the buckets, so that a group
+     is rarely searched needlessly.  */
+  uint32_t nbuckets = SCOPE_SUMMARY_MIN_BUCKETS;
+  unsigned int shift = 6;
+  while (nbuckets < nsyms / 2 && nbuckets < SCOPE_SUMMARY_MAX_BUCKETS)
+    {
+      nbuckets *= 2;
+      ++shift;
+    }
+
+  size_t size = (sizeof (struct r_scope_summary)
+		 + nbuckets * sizeof (uint64_t));
+  void *p = __mmap (NULL, size, PROT_READ | PROT_WRITE,
+		    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED)
+    return;
+
+  struct r_scope_summary *summary = p;
+  summary->nlist = nlist;
+  summary->group_size = (nlist + 63) / 64;
+  summary->shift = shift;
+  summary->mask = nbuckets - 1;
+  summary->always = 0;
+
+  for (unsigned int i = 0; i < nlist; ++i)
+    {
+      const struct link_map *map = scope->r_list[i]->l_real;
+      struct scope_summary_add_closure c =
+	{
+	  .summary = summary,
+	  .bit = 1ULL << (i / summary->group_size)
+	};
+      if (map->l_gnu_bitmask != NULL)
+	scope_summary_foreach_hash (map, scope_summary_add, &c);
+      else if (map->l_nbuckets != 0)
+	summary->always |= c.bit;
+    }
+
+  scope->r_summary = summary;
+}
+#endif
+
+/* Return the groups of the objects summarized in SUMMARY which may
+   define a symbol with hash NEW_HASH.  */
+static inline uint64_t
+scope_summary_candidates (const struct r_scope_summary *summary,
+			  uint_fast32_t new_hash)
+{
+  uint32_t hash = new_hash >> 1;
+  return (summary->always
+	  | (summary->buckets[hash & summary->mask]
+	     & summary->buckets[(hash >> summary->shift) & summary->mask]));
+}
+
+/* Return the first index at or after I of an object in a group in
+   CANDIDATES, or SUMMARY->nlist if there is none.  */
+static inline size_t
+scope_summary_next (const struct r_scope_summary *summary,
+		    uint64_t candidates, size_t i)
+{
+  unsigned int group = i / summary->group_size;
+  uint64_t rest = candidates & (~0ULL << group);
+  if (rest == 0)
+    return summary->nlist;
+  unsigned int next = __builtin_ctzll (rest);
+  if (next != group)
+    i = next * summary->group_size;
+  return i < summary->nlist ? i : summary->nlist;
+}
+
 /* Inner part of the lookup functions.  We return a value > 0 if we
    found the symbol, the value 0 if nothing is found and < 0 if
    something bad happened.  */
@@ -368,8 +543,26 @@ do_lookup_x (const char *undef_name, uint_fast32_t new_hash,
   __asm volatile ("" : "+r" (n), "+m" (scope->r_list));
   struct link_map **list = scope->r_list;
 
+  /* Objects covered by the summary of the scope which cannot define
+     the symbol are skipped.  */
+  const struct r_scope_summary *summary = scope->r_summary;
+  size_t summary_nlist = 0;
+  uint64_t candidates = 0;
+  if (summary != NULL && summary->nlist <= n)
+    {
+      summary_nlist = summary->nlist;
+      candidates = scope_summary_candidates (summary, new_hash);
+    }
+
   do
     {
+      if (i < summary_nlist)
+	{
+	  i = scope_summary_next (summary, candidates, i);
+	  if (i >= n)
+	    break;
+	}
+
       const struct link_map *map = list[i]->l_real;
 
       /* Here come the extra test needed for `_dl_lookup_symbol_skip'.  */
@@ -422,6 +615,7 @@ do_lookup_x (const char *undef_name, uint_fast32_t new_hash,
 	      if (bucket != 0)
 		{
 		  const Elf32_Word *hasharr = &map->l_gnu_chain_zero[bucket];
+		  const Elf32_Word *chain = hasharr;
 
 		  do
 		    if (((*hasharr ^ new_hash) >> 1) == 0)
@@ -432,9 +626,16 @@ do_lookup_x (const char *undef_name, uint_fast32_t new_hash,
 					   strtab, map, &versioned_sym,
 					   &num_versions);
 			if (sym != NULL)
-			  goto found_it;
+			  {
+			    profile_lookup (undef_map, hash_chain_steps,
+					    hasharr - chain + 1);
+			    goto found_it;
+			  }
 		      }
 		  while ((*hasharr++ & 1u) == 0);
+
+		  profile_lookup (undef_map, hash_chain_steps,
+				  hasharr - chain);
 		}
 	    }
 	  /* No symbol found.  */
@@ -572,10 +773,7 @@ skip:
 static uint_fast32_t
 dl_new_hash (const char *s)
 {
-  uint_fast32_t h = 5381;
-  for (unsigned char c = *s; c != '\0'; c = *++s)
-    h = h * 33 + c;
-  return h & 0xffffffff;
+  return poly_hash_string (5381, s, 33);
 }
 
 
@@ -819,6 +1017,187 @@ _dl_debug_bindings (const char *undef_name, struct link_map *undef_map,
 		    const struct r_found_version *version, int type_class,
 		    int protected);
 
+#ifdef SHARED
+/* Cache of symbol lookups in the global scope, used during the initial
+   relocation of the objects loaded at startup.  Most objects import the
+   same symbols (e.g. from libc or libstdc++), and without the cache each
+   of these lookups walks the hash tables of the objects in the global
+   scope until it finds a definition.  While the global scope does not
+   change, the result of such a lookup only depends on the symbol name,
+   version, type class and the DL_LOOKUP_RETURN_NEWEST flag.  */
+struct lookup_cache_entry
+{
+  const char *name;
+  const struct r_found_version *version;
+  struct sym_val value;
+  uint32_t hash;
+  int type_class;
+  int flags;
+};
+
+static struct
+{
+  /* Open-addressing hash table with linear probing, or NULL if the
+     cache is disabled.  */
+  struct lookup_cache_entry *table;
+  /* Number of entries in TABLE minus one.  */
+  size_t mask;
+  /* Number of used entries in TABLE.  */
+  size_t used;
+  /* The global scope and its size when the cache was set up.  */
+  struct r_scope_elem *scope;
+  unsigned int nlist;
+} lookup_cache;
+
+/* Initial number of entries in the cache.  Must be a power of two.
+   This fits into a single page, so that programs with few imports do
+   not pay for a large mapping.  lookup_cache_insert doubles the size as
+   needed.  */
+#define LOOKUP_CACHE_INITIAL_SIZE 64
+
+static struct lookup_cache_entry *
+lookup_cache_alloc (size_t nentries)
+{
+  void *p = __mmap (NULL, nentries * sizeof (struct lookup_cache_entry),
+		    PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+		    -1, 0);
+  return p == MAP_FAILED ? NULL : p;
+}
+
+static void
+lookup_cache_free (struct lookup_cache_entry *table, size_t nentries)
+{
+  __munmap (table, nentries * sizeof (struct lookup_cache_entry));
+}
+
+void
+_dl_lookup_cache_init (struct link_map *main_map)
+{
+  /* Keep the output of LD_DEBUG=symbols complete.  */
+  if (GLRO(dl_debug_mask) & DL_DEBUG_SYMBOLS)
+    return;
+
+  lookup_cache.table = lookup_cache_alloc (LOOKUP_CACHE_INITIAL_SIZE);
+  if (lookup_cache.table == NULL)
+    return;
+  lookup_cache.mask = LOOKUP_CACHE_INITIAL_SIZE - 1;
+  lookup_cache.used = 0;
+  lookup_cache.scope = &main_map->l_searchlist;
+  lookup_cache.nlist = main_map->l_searchlist.r_nlist;
+}
+
+void
+_dl_lookup_cache_fini (void)
+{
+  if (lookup_cache.table != NULL)
+    lookup_cache_free (lookup_cache.table, lookup_cache.mask + 1);
+  lookup_cache.table = NULL;
+}
+
+/* Return true if the result of a lookup with these arguments may be
+   taken from or stored in the cache.  */
+static inline bool
+lookup_cache_usable (struct r_scope_elem *symbol_scope[],
+		     struct link_map *undef_map, struct link_map *skip_map)
+{
+  /* Objects with DT_SYMBOLIC or loaded with RTLD_DEEPBIND have a
+     different scope.  Objects added to the global scope (by dlopen from
+     an IFUNC resolver, for example) can change the result.  */
+  return (lookup_cache.table != NULL
+	  && symbol_scope[0] == lookup_cache.scope
+	  && symbol_scope[1] == NULL
+	  && lookup_cache.scope->r_nlist == lookup_cache.nlist
+	  && undef_map != NULL
+	  && skip_map == NULL);
+}
+
+static inline bool
+lookup_cache_match (const struct lookup_cache_entry *entry,
+		    const char *undef_name, uint32_t new_hash,
+		    const struct r_found_version *version, int type_class,
+		    int flags)
+{
+  if (entry->hash != new_hash
+      || entry->type_class != type_class
+      || entry->flags != flags
+      || strcmp (entry->name, undef_name) != 0)
+    return false;
+  if (version == NULL || entry->version == NULL)
+    return version == entry->version;
+  return (version->hash == entry->version->hash
+	  && version->hidden == entry->version->hidden
+	  && strcmp (version->name, entry->version->name) == 0);
+}
+
+/* Return the entry for the lookup, or the empty slot where it should be
+   inserted.  */
+static struct lookup_cache_entry *
+lookup_cache_find (const char *undef_name, uint32_t new_hash,
+		   const struct r_found_version *version, int type_class,
+		   int flags)
+{
+  size_t idx = new_hash & lookup_cache.mask;
+  while (true)
+    {
+      struct lookup_cache_entry *entry = &lookup_cache.table[idx];
+      if (entry->name == NULL
+	  || lookup_cache_match (entry, undef_name, new_hash, version,
+				 type_class, flags))
+	return entry;
+      idx = (idx + 1) & lookup_cache.mask;
+    }
+}
+
+/* Double the size of the cache.  On failure, the cache stays as it is
+   and false is returned.  */
+static bool
+lookup_cache_grow (void)
+{
+  size_t oldsize = lookup_cache.mask + 1;
+  struct lookup_cache_entry *oldtable = lookup_cache.table;
+  struct lookup_cache_entry *newtable = lookup_cache_alloc (2 * oldsize);
+  if (newtable == NULL)
+    return false;
+
+  lookup_cache.table = newtable;
+  lookup_cache.mask = 2 * oldsize - 1;
+  for (size_t i = 0; i < oldsize; ++i)
+    if (oldtable[i].name != NULL)
+      {
+	size_t idx = oldtable[i].hash & lookup_cache.mask;
+	while (newtable[idx].name != NULL)
+	  idx = (idx + 1) & lookup_cache.mask;
+	newtable[idx] = oldtable[i];
+      }
+  lookup_cache_free (oldtable, oldsize);
+  return true;
+}
+
+static void
+lookup_cache_insert (struct lookup_cache_entry *entry,
+		     const char *undef_name, uint32_t new_hash,
+		     const struct r_found_version *version, int type_class,
+		     int flags, const struct sym_val *value)
+{
+  /* Keep the load factor below 3/4.  */
+  if (4 * (lookup_cache.used + 1) > 3 * (lookup_cache.mask + 1))
+    {
+      if (!lookup_cache_grow ())
+	return;
+      entry = lookup_cache_find (undef_name, new_hash, version, type_class,
+				 flags);
+    }
+
+  entry->name = undef_name;
+  entry->version = version;
+  entry->value = *value;
+  entry->hash = new_hash;
+  entry->type_class = type_class;
+  entry->flags = flags;
+  ++lookup_cache.used;
+}
+#endif
+
 
 /* Search loaded objects' symbol tables for a definition of the symbol
    UNDEF_NAME, perhaps with a requested version for the symbol.
@@ -839,6 +1218,7 @@ _dl_lookup_symbol_x (const char *undef_name, struct link_map *undef_map,
   struct r_scope_elem **scope = symbol_scope;
 
   bump_num_relocations ();
+  profile_lookup (undef_map, lookups, 1);
 
   /* DL_LOOKUP_RETURN_NEWEST does not make sense for versioned
      lookups.  */
@@ -850,12 +1230,37 @@ _dl_lookup_symbol_x (const char *undef_name, struct link_map *undef_map,
     while ((*scope)->r_list[i] != skip_map)
       ++i;
 
-  /* Search the relevant loaded objects for a definition.  */
-  for (size_t start = i; *scope != NULL; start = 0, ++scope)
-    if (do_lookup_x (undef_name, new_hash, &old_hash, *ref,
-		     &current_value, *scope, start, version, flags,
-		     skip_map, type_class, undef_map) != 0)
-      break;
+#ifdef SHARED
+  struct lookup_cache_entry *cache_entry = NULL;
+  int cache_flags = flags & DL_LOOKUP_RETURN_NEWEST;
+  if (__glibc_likely (lookup_cache_usable (symbol_scope, undef_map,
+					   skip_map)))
+    {
+      cache_entry = lookup_cache_find (undef_name, new_hash, version,
+				       type_class, cache_flags);
+      if (cache_entry->name != NULL)
+	current_value = cache_entry->value;
+    }
+  if (current_value.s == NULL)
+#endif
+    {
+      /* Search the relevant loaded objects for a definition.  */
+      for (size_t start = i; *scope != NULL; start = 0, ++scope)
+	if (do_lookup_x (undef_name, new_hash, &old_hash, *ref,
+			 &current_value, *scope, start, version, flags,
+			 skip_map, type_class, undef_map) != 0)
+	  break;
+
+#ifdef SHARED
+      /* STB_GNU_UNIQUE lookups have side effects, so they are not
+	 cached.  */
+      if (cache_entry != NULL
+	  && current_value.s != NULL
+	  && ELFW(ST_BIND) (current_value.s->st_info) != STB_GNU_UNIQUE)
+	lookup_cache_insert (cache_entry, undef_name, new_hash, version,
+			     type_class, cache_flags, &current_value);
+#endif
+    }
 
   if (__glibc_unlikely (current_value.s == NULL))
     {
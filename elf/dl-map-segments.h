@@ -16,6 +16,7 @@
    License along with the GNU C Library; if not, see
    <https://www.gnu.org/licenses/>.  */
 
+#include <dl-hugepages.h>
 #include <dl-load.h>
 
 /* This implementation assumes (as does the corresponding implementation
@@ -25,6 +26,60 @@
    pages inside the gaps with PROT_NONE mappings rather than permitting
    other use of those parts of the address space).  */
 
+/* Return the huge page size if the executable segments among LOADCMDS
+   are to be backed by huge pages, or 0.  Besides the glibc.rtld.hugepages
+   tunable, this needs a segment alignment of at least the huge page
+   size, so that file offsets and addresses of the segments are
+   congruent modulo the huge page size.  */
+static __always_inline size_t
+_dl_map_segments_hugepage (const struct loadcmd loadcmds[], size_t nloadcmds)
+{
+  size_t size = _dl_hugepage_size ();
+  if (__glibc_likely (size == 0))
+    return 0;
+  for (size_t i = 0; i < nloadcmds; ++i)
+    if ((loadcmds[i].prot & PROT_EXEC) != 0 && loadcmds[i].mapalign >= size)
+      return size;
+  return 0;
+}
+
+/* Map MAPLENGTH bytes starting with the first segment C of an ET_DYN
+   object like _dl_map_segments, but at an address for which the load
+   address is a multiple of ALIGN.  */
+static __always_inline void *
+_dl_map_segment_aligned (const struct loadcmd *c, ElfW(Addr) mappref,
+                         const size_t maplength, size_t align, int fd)
+{
+  /* Reserve enough address space for any alignment, then map the
+     object into it and release the excess.  */
+  size_t reservelength = maplength + align;
+  void *reserve = __mmap ((void *) mappref, reservelength, PROT_NONE,
+                          MAP_ANON|MAP_PRIVATE, -1, 0);
+  if (__glibc_unlikely (reserve == MAP_FAILED))
+    return MAP_FAILED;
+  ElfW(Addr) reservestart = (ElfW(Addr)) reserve;
+  ElfW(Addr) reserveend = reservestart + reservelength;
+
+  /* The load address is the address of the first segment minus
+     C->mapstart.  */
+  ElfW(Addr) start = (ALIGN_UP (reservestart - c->mapstart, align)
+                      + c->mapstart);
+  void *map = __mmap ((void *) start, maplength, c->prot,
+                      MAP_FIXED|MAP_COPY|MAP_FILE, fd, c->mapoff);
+  if (__glibc_unlikely (map == MAP_FAILED))
+    {
+      __munmap (reserve, reservelength);
+      return MAP_FAILED;
+    }
+
+  if (start > reservestart)
+    __munmap (reserve, start - reservestart);
+  ElfW(Addr) end = ALIGN_UP (start + maplength, GLRO(dl_pagesize));
+  if (reserveend > end)
+    __munmap ((void *) end, reserveend - end);
+  return map;
+}
+
 static __always_inline const char *
 _dl_map_segments (struct link_map *l, int fd,
                   const ElfW(Ehdr) *header, int type,
@@ -33,6 +88,7 @@ _dl_map_segments (struct link_map *l, int fd,
                   struct link_map *loader)
 {
   const struct loadcmd *c = loadcmds;
+  size_t hugepage = _dl_map_segments_hugepage (loadcmds, nloadcmds);
 
   if (__glibc_likely (type == ET_DYN))
     {
@@ -53,10 +109,15 @@ _dl_map_segments (struct link_map *l, int fd,
            - MAP_BASE_ADDR (l));
 
       /* Remember which part of the address space this object uses.  */
-      l->l_map_start = (ElfW(Addr)) __mmap ((void *) mappref, maplength,
-                                            c->prot,
-                                            MAP_COPY|MAP_FILE,
-                                            fd, c->mapoff);
+      if (__glibc_unlikely (hugepage != 0))
+        l->l_map_start = (ElfW(Addr)) _dl_map_segment_aligned (c, mappref,
+                                                               maplength,
+                                                               hugepage, fd);
+      else
+        l->l_map_start = (ElfW(Addr)) __mmap ((void *) mappref, maplength,
+                                              c->prot,
+                                              MAP_COPY|MAP_FILE,
+                                              fd, c->mapoff);
       if (__glibc_unlikely ((void *) l->l_map_start == MAP_FAILED))
         return DL_MAP_SEGMENTS_ERROR_MAP_SEGMENT;
 
@@ -101,6 +162,10 @@ _dl_map_segments (struct link_map *l, int fd,
     postmap:
       _dl_postprocess_loadcmd (l, header, c);
 
+      if (__glibc_unlikely (hugepage != 0) && (c->prot & PROT_EXEC) != 0)
+        _dl_hugepage_advise (l->l_addr + c->mapstart, l->l_addr + c->mapend,
+                             hugepage);
+
       if (c->allocend > c->dataend)
         {
           /* Extra zero pages should appear at the end of this segment,
@@ -201,28 +201,6 @@ add_to_global_update (struct link_map *new)
   ns->_ns_main_searchlist->r_nlist = new_nlist;
 }
 
-/* Search link maps in all namespaces for the DSO that contains the object at
-   address ADDR.  Returns the pointer to the link map of the matching DSO, or
-   NULL if a match is not found.  */
-struct link_map *
-_dl_find_dso_for_object (const ElfW(Addr) addr)
-{
-  struct link_map *l;
-
-  /* Find the highest-addressed object that ADDR is not below.  */
-  for (Lmid_t ns = 0; ns < GL(dl_nns); ++ns)
-    for (l = GL(dl_ns)[ns]._ns_loaded; l != NULL; l = l->l_next)
-      if (addr >= l->l_map_start && addr < l->l_map_end
-	  && (l->l_contiguous
-	      || _dl_addr_inside_object (l, (ElfW(Addr)) addr)))
-	{
-	  assert (ns == l->l_ns);
-	  return l;
-	}
-  return NULL;
-}
-rtld_hidden_def (_dl_find_dso_for_object);
-
 /* Return true if NEW is found in the scope for MAP.  */
 static size_t
 scope_has_map (struct link_map *map, struct link_map *new)
@@ -372,6 +350,28 @@ resize_tls_slotinfo (struct link_map *new)
   return any_tls;
 }
 
+/* Place the TLS blocks of the newly loaded objects of NEW in the
+   optional part of the surplus static TLS, as far as it is available.
+   The blocks are then initialized in all threads by
+   update_tls_slotinfo, and accessing them does not require allocating
+   memory or taking locks.  Objects which do not fit fall back to
+   dynamic TLS.  This must be called before the objects are relocated,
+   so that their own TLS relocations can use the static offset.  */
+static void
+reserve_static_tls (struct link_map *new)
+{
+  for (unsigned int i = 0; i < new->l_searchlist.r_nlist; ++i)
+    {
+      struct link_map *imap = new->l_searchlist.r_list[i];
+
+      if (! imap->l_init_called && ! imap->l_relocated
+	  && imap->l_tls_blocksize > 0
+	  && imap->l_tls_offset == NO_TLS_OFFSET
+	  && _dl_try_allocate_static_tls (imap, true) == 0)
+	imap->l_tls_static_eager = 1;
+    }
+}
+
 /* Second stage of TLS update, after resize_tls_slotinfo.  This
    function does not raise any exception.  It should only be called if
    resize_tls_slotinfo returned true.  */
@@ -395,9 +395,12 @@ update_tls_slotinfo (struct link_map *new)
 	}
     }
 
-  if (__builtin_expect (++GL(dl_tls_generation) == 0, 0))
+  size_t newgen = GL(dl_tls_generation) + 1;
+  if (__glibc_unlikely (newgen == 0))
     _dl_fatal_printf (N_("\
 TLS generation counter wrapped!  Please report this."));
+  /* Can be read concurrently by __tls_get_addr.  */
+  atomic_store_relaxed (&GL(dl_tls_generation), newgen);
 
   /* We need a second pass for static tls data, because
      _dl_update_slotinfo must not be run while calls to
@@ -590,6 +593,12 @@ dl_open_worker (void *a)
       (void) _dl_check_map_versions (new->l_searchlist.r_list[i]->l_real,
 				     0, 0);
 
+  /* Make the new objects available to _dl_find_object before any code
+     in them runs.  */
+  if (!_dl_find_object_update ())
+    _dl_signal_error (ENOMEM, new->l_libname->name, NULL,
+		      N_("cannot allocate address lookup data"));
+
 #ifdef SHARED
   /* Auditing checkpoint: we have added all objects.  */
   if (__glibc_unlikely (GLRO(dl_naudit) > 0))
@@ -652,6 +661,8 @@ dl_open_worker (void *a)
 
   int relocation_in_progress = 0;
 
+  reserve_static_tls (new);
+
   /* Perform relocation.  This can trigger lazy binding in IFUNC
      resolvers.  For NODELETE mappings, these dependencies are not
      recorded because the flag has not been applied to the newly
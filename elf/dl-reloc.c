@@ -26,6 +26,7 @@
 #include <sys/types.h>
 #include <_itoa.h>
 #include <libc-pointer-arith.h>
+#include <dl-startup-profile.h>
 #include "dynamic-link.h"
 
 /* Statistics function.  */
@@ -161,6 +162,20 @@ _dl_nothread_init_static_tls (struct link_map *map)
 }
 
 
+#ifdef SHARED
+/* Return true if an auditor intercepts calls through the PLT with
+   la_pltenter or la_pltexit.  */
+static bool
+audit_intercepts_plt (void)
+{
+  for (struct audit_ifaces *afct = GLRO(dl_audit); afct != NULL;
+       afct = afct->next)
+    if (afct->ARCH_LA_PLTENTER != NULL || afct->ARCH_LA_PLTEXIT != NULL)
+      return true;
+  return false;
+}
+#endif
+
 void
 _dl_relocate_object (struct link_map *l, struct r_scope_elem *scope[],
 		     int reloc_mode, int consider_profiling)
@@ -178,21 +193,33 @@ _dl_relocate_object (struct link_map *l, struct r_scope_elem *scope[],
   int skip_ifunc = reloc_mode & __RTLD_NOIFUNC;
 
 #ifdef SHARED
-  /* If we are auditing, install the same handlers we need for profiling.  */
-  if ((reloc_mode & __RTLD_AUDIT) == 0)
-    consider_profiling |= GLRO(dl_audit) != NULL;
-#elif defined PROF
+  /* If we are auditing, PLT entries are bound lazily, so that the
+     auditors see the bindings in la_symbind.  Only if an auditor
+     intercepts the calls themselves, install the same handlers we need
+     for profiling, which run on every call.  Otherwise _dl_fixup
+     reports the binding and patches the GOT as usual.  */
+  bool auditing = (reloc_mode & __RTLD_AUDIT) == 0 && GLRO(dl_audit) != NULL;
+  if (auditing && audit_intercepts_plt ())
+    consider_profiling = 1;
+#else
+  const bool auditing = false;
+# ifdef PROF
   /* Never use dynamic linker profiling for gprof profiling code.  */
-# define consider_profiling 0
+#  define consider_profiling 0
+# endif
 #endif
 
   if (l->l_relocated)
     return;
 
+  struct dl_startup_profile *profile = _dl_startup_profile (l);
+  hp_timing_t profile_start = 0;
+  if (__glibc_unlikely (profile != NULL))
+    _dl_startup_profile_start (&profile_start);
+
   /* If DT_BIND_NOW is set relocate all references in this object.  We
-     do not do this if we are profiling, of course.  */
-  // XXX Correct for auditing?
-  if (!consider_profiling
+     do not do this if we are profiling or auditing, of course.  */
+  if (!consider_profiling && !auditing
       && __builtin_expect (l->l_info[DT_BIND_NOW] != NULL, 0))
     lazy = 0;
 
@@ -320,6 +347,9 @@ _dl_relocate_object (struct link_map *l, struct r_scope_elem *scope[],
      done, do it.  */
   if (l->l_relro_size != 0)
     _dl_protect_relro (l);
+
+  if (__glibc_unlikely (profile != NULL))
+    _dl_startup_profile_accum (&profile->relocate_time, profile_start);
 }
 
 
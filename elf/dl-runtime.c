@@ -43,6 +43,96 @@
 # define ARCH_FIXUP_ATTRIBUTE
 #endif
 
+#ifdef SHARED
+/* Report the binding of the PLT relocation in L to DEFSYM in RESULT,
+   with the address VALUE, to the la_symbind callbacks of the auditors,
+   and record it in *RELOC_RESULT.  Return the address to which the
+   relocation is to be bound, which the auditors may have changed.  */
+static DL_FIXUP_VALUE_TYPE
+audit_symbind (struct link_map *l, struct reloc_result *reloc_result,
+	       const ElfW(Sym) *defsym, lookup_t result,
+	       DL_FIXUP_VALUE_TYPE value)
+{
+  reloc_result->bound = result;
+  /* Compute index of the symbol entry in the symbol table of
+     the DSO with the definition.  */
+  reloc_result->boundndx = (defsym
+			    - (ElfW(Sym) *) D_PTR (result,
+						   l_info[DT_SYMTAB]));
+
+  /* Determine whether any of the two participating DSOs is
+     interested in auditing.  */
+  if ((l->l_audit_any_plt | result->l_audit_any_plt) != 0)
+    {
+      unsigned int flags = 0;
+      struct audit_ifaces *afct = GLRO(dl_audit);
+      /* Synthesize a symbol record where the st_value field is
+	 the result.  */
+      ElfW(Sym) sym = *defsym;
+      sym.st_value = DL_FIXUP_VALUE_ADDR (value);
+
+      /* Keep track whether there is any interest in tracing
+	 the call in the lower two bits.  */
+      assert (DL_NNS * 2 <= sizeof (reloc_result->flags) * 8);
+      assert ((LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT) == 3);
+      reloc_result->enterexit = LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT;
+
+      const char *strtab2 = (const void *) D_PTR (result,
+						  l_info[DT_STRTAB]);
+
+      for (unsigned int cnt = 0; cnt < GLRO(dl_naudit); ++cnt)
+	{
+	  /* XXX Check whether both DSOs must request action or
+	     only one */
+	  struct auditstate *l_state = link_map_audit_state (l, cnt);
+	  struct auditstate *result_state
+	    = link_map_audit_state (result, cnt);
+	  if ((l_state->bindflags & LA_FLG_BINDFROM) != 0
+	      && (result_state->bindflags & LA_FLG_BINDTO) != 0)
+	    {
+	      if (afct->symbind != NULL)
+		{
+		  uintptr_t new_value
+		    = afct->symbind (&sym, reloc_result->boundndx,
+				     &l_state->cookie,
+				     &result_state->cookie,
+				     &flags,
+				     strtab2 + defsym->st_name);
+		  if (new_value != (uintptr_t) sym.st_value)
+		    {
+		      flags |= LA_SYMB_ALTVALUE;
+		      sym.st_value = new_value;
+		    }
+		}
+
+	      /* Remember the results for every audit library and
+		 store a summary in the first two bits.  */
+	      reloc_result->enterexit
+		&= flags & (LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT);
+	      reloc_result->enterexit
+		|= ((flags & (LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT))
+		    << ((cnt + 1) * 2));
+	    }
+	  else
+	    /* If the bind flags say this auditor is not interested,
+	       set the bits manually.  */
+	    reloc_result->enterexit
+	      |= ((LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT)
+		  << ((cnt + 1) * 2));
+
+	  afct = afct->next;
+	}
+
+      reloc_result->flags = flags;
+      value = DL_FIXUP_ADDR_VALUE (sym.st_value);
+    }
+  else
+    /* Set all bits since this symbol binding is not interesting.  */
+    reloc_result->enterexit = (1u << DL_NNS) - 1;
+  return value;
+}
+#endif
+
 /* This function is called through a special trampoline from the PLT the
    first time each PLT entry is called.  We must perform the relocation
    specified in the PLT of the given shared object, and return the resolved
@@ -138,6 +228,18 @@ _dl_fixup (
       && __builtin_expect (ELFW(ST_TYPE) (sym->st_info) == STT_GNU_IFUNC, 0))
     value = elf_ifunc_invoke (DL_FIXUP_VALUE_ADDR (value));
 
+#ifdef SHARED
+  /* Auditing checkpoint: we have a new binding.  _dl_relocate_object
+     only sends calls here if no auditor intercepts PLT calls, so the
+     binding (possibly changed by the auditors) is stored in the GOT
+     and later calls do not involve the dynamic linker.  */
+  if (sym != NULL && GLRO(dl_naudit) > 0)
+    {
+      struct reloc_result reloc_result;
+      value = audit_symbind (l, &reloc_result, sym, result, value);
+    }
+#endif
+
   /* Finally, fix up the plt itself.  */
   if (__glibc_unlikely (GLRO(dl_bind_not)))
     return value;
@@ -296,84 +398,7 @@ _dl_profile_fixup (
 	 auditing libraries the possibility to change the value and
 	 tell us whether further auditing is wanted.  */
       if (defsym != NULL && GLRO(dl_naudit) > 0)
-	{
-	  reloc_result->bound = result;
-	  /* Compute index of the symbol entry in the symbol table of
-	     the DSO with the definition.  */
-	  reloc_result->boundndx = (defsym
-				    - (ElfW(Sym) *) D_PTR (result,
-							   l_info[DT_SYMTAB]));
-
-	  /* Determine whether any of the two participating DSOs is
-	     interested in auditing.  */
-	  if ((l->l_audit_any_plt | result->l_audit_any_plt) != 0)
-	    {
-	      unsigned int flags = 0;
-	      struct audit_ifaces *afct = GLRO(dl_audit);
-	      /* Synthesize a symbol record where the st_value field is
-		 the result.  */
-	      ElfW(Sym) sym = *defsym;
-	      sym.st_value = DL_FIXUP_VALUE_ADDR (value);
-
-	      /* Keep track whether there is any interest in tracing
-		 the call in the lower two bits.  */
-	      assert (DL_NNS * 2 <= sizeof (reloc_result->flags) * 8);
-	      assert ((LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT) == 3);
-	      reloc_result->enterexit = LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT;
-
-	      const char *strtab2 = (const void *) D_PTR (result,
-							  l_info[DT_STRTAB]);
-
-	      for (unsigned int cnt = 0; cnt < GLRO(dl_naudit); ++cnt)
-		{
-		  /* XXX Check whether both DSOs must request action or
-		     only one */
-		  struct auditstate *l_state = link_map_audit_state (l, cnt);
-		  struct auditstate *result_state
-		    = link_map_audit_state (result, cnt);
-		  if ((l_state->bindflags & LA_FLG_BINDFROM) != 0
-		      && (result_state->bindflags & LA_FLG_BINDTO) != 0)
-		    {
-		      if (afct->symbind != NULL)
-			{
-			  uintptr_t new_value
-			    = afct->symbind (&sym, reloc_result->boundndx,
-					     &l_state->cookie,
-					     &result_state->cookie,
-					     &flags,
-					     strtab2 + defsym->st_name);
-			  if (new_value != (uintptr_t) sym.st_value)
-			    {
-			      flags |= LA_SYMB_ALTVALUE;
-			      sym.st_value = new_value;
-			    }
-			}
-
-		      /* Remember the results for every audit library and
-			 store a summary in the first two bits.  */
-		      reloc_result->enterexit
-			&= flags & (LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT);
-		      reloc_result->enterexit
-			|= ((flags & (LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT))
-			    << ((cnt + 1) * 2));
-		    }
-		  else
-		    /* If the bind flags say this auditor is not interested,
-		       set the bits manually.  */
-		    reloc_result->enterexit
-		      |= ((LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT)
-			  << ((cnt + 1) * 2));
-
-		  afct = afct->next;
-		}
-
-	      reloc_result->flags = flags;
-	      value = DL_FIXUP_ADDR_VALUE (sym.st_value);
-	    }
-	  else
-	    /* Set all bits since this symbol binding is not interesting.  */
-	    reloc_result->enterexit = (1u << DL_NNS) - 1;
-	}
+	value = audit_symbind (l, reloc_result, defsym, result, value);
 #endif
 
       /* Store the result for later runs.  */
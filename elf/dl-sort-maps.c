@@ -16,20 +16,20 @@
    License along with the GNU C Library; if not, see
    <https://www.gnu.org/licenses/>.  */
 
+#include <assert.h>
+#include <string.h>
 #include <ldsodefs.h>
+#include <dl-tunables.h>
 
 
 /* Sort array MAPS according to dependencies of the contained objects.
    Array USED, if non-NULL, is permutated along MAPS.  If FOR_FINI this is
-   called for finishing an object.  */
-void
-_dl_sort_maps (struct link_map **maps, unsigned int nmaps, char *used,
-	       bool for_fini)
+   called for finishing an object.  This is the original algorithm,
+   which needs quadratic time or worse.  */
+static void
+_dl_sort_maps_original (struct link_map **maps, unsigned int nmaps,
+			char *used, bool for_fini)
 {
-  /* A list of one element need not be sorted.  */
-  if (nmaps <= 1)
-    return;
-
   unsigned int i = 0;
   uint16_t seen[nmaps];
   memset (seen, 0, nmaps * sizeof (seen[0]));
@@ -120,3 +120,143 @@ _dl_sort_maps (struct link_map **maps, unsigned int nmaps, char *used,
     next:;
     }
 }
+
+/* Place MAP and, before it, all objects it depends on which have not
+   been visited yet in the array ending at *RPO, in reverse postorder.
+   *RPO points one past the last free element and is decremented for
+   each object placed.  If DO_RELDEPS is not NULL, relocation
+   dependencies are followed as well, and *DO_RELDEPS is set to true if
+   there are any.
+
+   The recursion depth is bounded by the length of the longest
+   dependency chain, similar to the stack usage of the breadth-first
+   search in _dl_map_object_deps.  */
+static void
+dfs_traversal (struct link_map ***rpo, struct link_map *map,
+	       bool *do_reldeps)
+{
+  map->l_visited = 1;
+
+  if (map->l_initfini != NULL)
+    for (struct link_map **runp = map->l_initfini; *runp != NULL; ++runp)
+      if ((*runp)->l_visited == 0)
+	dfs_traversal (rpo, *runp, do_reldeps);
+
+  if (__glibc_unlikely (do_reldeps != NULL && map->l_reldeps != NULL))
+    {
+      *do_reldeps = true;
+
+      for (int m = map->l_reldeps->act - 1; m >= 0; m--)
+	{
+	  struct link_map *dep = map->l_reldeps->list[m];
+	  if (dep->l_visited == 0)
+	    dfs_traversal (rpo, dep, do_reldeps);
+	}
+    }
+
+  *rpo -= 1;
+  **rpo = map;
+}
+
+/* Prepare the l_visited flags for dfs_traversal over MAPS.  The
+   traversal must only place the objects in MAPS, but dependencies can
+   lead outside of the array, for example back to the object whose
+   dependencies are being sorted by _dl_map_object_deps, or to the main
+   program.  The direct dependencies of the objects in MAPS are marked
+   as visited, and then the marks of the objects in MAPS are cleared
+   again.  */
+static void
+dfs_init_visited (struct link_map **maps, unsigned int nmaps, bool reldeps)
+{
+  for (unsigned int i = 0; i < nmaps; i++)
+    {
+      struct link_map *map = maps[i];
+      if (map->l_initfini != NULL)
+	for (struct link_map **runp = map->l_initfini; *runp != NULL; ++runp)
+	  (*runp)->l_visited = 1;
+      if (reldeps && map->l_reldeps != NULL)
+	for (unsigned int m = 0; m < map->l_reldeps->act; m++)
+	  map->l_reldeps->list[m]->l_visited = 1;
+    }
+
+  for (unsigned int i = 0; i < nmaps; i++)
+    maps[i]->l_visited = 0;
+}
+
+/* Sort array MAPS topologically, using a depth-first search.  The
+   result is the reverse postorder of the search, so every object comes
+   before the objects it depends on.  This takes time linear in the
+   number of objects and dependency links.  */
+static void
+_dl_sort_maps_dfs (struct link_map **maps, unsigned int nmaps,
+		   char *used, bool for_fini)
+{
+  /* Carry the USED flags along with the objects.  */
+  if (used != NULL)
+    for (unsigned int i = 0; i < nmaps; i++)
+      maps[i]->l_map_used = used[i];
+
+  dfs_init_visited (maps, nmaps, for_fini);
+
+  /* The traversal starts from the last object.  MAPS is usually in
+     breadth-first order, so this keeps the recursion shallow, and the
+     result close to the original link order for simple cases.  */
+  struct link_map *rpo[nmaps];
+  struct link_map **rpo_head = &rpo[nmaps];
+  bool do_reldeps = false;
+  bool *do_reldeps_ref = for_fini ? &do_reldeps : NULL;
+
+  for (int i = nmaps - 1; i >= 0 && rpo_head != rpo; i--)
+    if (maps[i]->l_visited == 0)
+      dfs_traversal (&rpo_head, maps[i], do_reldeps_ref);
+  assert (rpo_head == rpo);
+
+  if (__glibc_unlikely (do_reldeps))
+    {
+      /* The first pass treated dependencies from relocations like
+	 link-time dependencies, which may not respect the link-time
+	 dependencies in a cycle that involves both.  Destructors should
+	 follow the link-time dependencies where possible, so sort again
+	 using only those, starting from the order found so far.  */
+      dfs_init_visited (rpo, nmaps, false);
+
+      struct link_map **maps_head = &maps[nmaps];
+      for (int i = nmaps - 1; i >= 0 && maps_head != maps; i--)
+	if (rpo[i]->l_visited == 0)
+	  dfs_traversal (&maps_head, rpo[i], NULL);
+      assert (maps_head == maps);
+    }
+  else
+    memcpy (maps, rpo, nmaps * sizeof (struct link_map *));
+
+  if (used != NULL)
+    for (unsigned int i = 0; i < nmaps; i++)
+      used[i] = maps[i]->l_map_used;
+}
+
+void
+_dl_sort_maps_init (void)
+{
+#if HAVE_TUNABLES
+  int32_t algorithm = TUNABLE_GET_FULL (glibc, rtld, dynamic_sort, int32_t,
+					NULL);
+  GLRO(dl_dso_sort_algo) = (algorithm == 2 ? dso_sort_algorithm_dfs
+			    : dso_sort_algorithm_original);
+#else
+  GLRO(dl_dso_sort_algo) = dso_sort_algorithm_original;
+#endif
+}
+
+void
+_dl_sort_maps (struct link_map **maps, unsigned int nmaps, char *used,
+	       bool for_fini)
+{
+  /* A list of one element need not be sorted.  */
+  if (nmaps <= 1)
+    return;
+
+  if (GLRO(dl_dso_sort_algo) == dso_sort_algorithm_dfs)
+    _dl_sort_maps_dfs (maps, nmaps, used, for_fini);
+  else
+    _dl_sort_maps_original (maps, nmaps, used, for_fini);
+}
@@ -0,0 +1,146 @@
+/* Recording and output of the dynamic linker startup profile.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+
+#include <_itoa.h>
+#include <dl-startup-profile.h>
+#include <fcntl.h>
+#include <not-cancel.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct dl_startup_profile *
+_dl_startup_profile_add (struct link_map *l)
+{
+  if (GL(dl_startup_profile_output) == NULL)
+    return NULL;
+
+  /* Objects for which the allocation fails are not profiled.  */
+  if (l->l_startup_profile == NULL)
+    l->l_startup_profile = calloc (1, sizeof (*l->l_startup_profile));
+  return l->l_startup_profile;
+}
+
+/* Write S to FD as a JSON string.  */
+static void
+write_string (int fd, const char *s)
+{
+  _dl_dprintf (fd, "\"");
+  while (*s != '\0')
+    {
+      size_t len = 0;
+      while (s[len] != '\0' && s[len] != '"' && s[len] != '\\'
+	     && (unsigned char) s[len] >= ' ')
+	++len;
+      if (len > 0)
+	{
+	  _dl_dprintf (fd, "%.*s", (int) len, s);
+	  s += len;
+	}
+      else
+	{
+	  if (*s == '"' || *s == '\\')
+	    _dl_dprintf (fd, "\\%.*s", 1, s);
+	  else
+	    _dl_dprintf (fd, "\\u%0*x", 4, (unsigned int) (unsigned char) *s);
+	  ++s;
+	}
+    }
+  _dl_dprintf (fd, "\"");
+}
+
+/* Write the member NAME with value T to FD.  */
+static void
+write_time (int fd, const char *name, hp_timing_t t)
+{
+  char buf[HP_TIMING_PRINT_SIZE];
+  HP_TIMING_PRINT (buf, sizeof (buf), t);
+  _dl_dprintf (fd, ", \"%s\": %s", name, buf);
+}
+
+static void
+write_object (int fd, struct link_map *l)
+{
+  const struct dl_startup_profile *p = l->l_startup_profile;
+
+  const char *name = l->l_name;
+  if (name[0] == '\0' && l == GL(dl_ns)[LM_ID_BASE]._ns_loaded
+      && _dl_argv[0] != NULL)
+    name = _dl_argv[0];
+
+  _dl_dprintf (fd, "    {\"name\": ");
+  write_string (fd, name);
+  _dl_dprintf (fd, ", \"namespace\": %lu", (unsigned long int) l->l_ns);
+  write_time (fd, "map", p->map_time);
+  write_time (fd, "relocate", p->relocate_time);
+  write_time (fd, "ifunc", p->ifunc_time);
+  write_time (fd, "init", p->init_time);
+  _dl_dprintf (fd, ", \"ifunc_calls\": %lu, \"lookups\": %lu,"
+	       " \"hash_chain_steps\": %lu}",
+	       p->ifunc_calls, p->lookups, p->hash_chain_steps);
+}
+
+void
+_dl_startup_profile_write (void)
+{
+  const char *output = GL(dl_startup_profile_output);
+  if (output == NULL)
+    return;
+
+  /* Objects loaded from now on are not profiled.  */
+  GL(dl_startup_profile_output) = NULL;
+
+  /* Append the process ID, as for LD_DEBUG_OUTPUT, so that processes
+     started with the same environment do not overwrite each other's
+     profile.  */
+  size_t name_len = strlen (output);
+  char buf[name_len + 12];
+  buf[name_len + 11] = '\0';
+  char *startp = _itoa (__getpid (), &buf[name_len + 11], 10, 0);
+  *--startp = '.';
+  startp = memcpy (startp - name_len, output, name_len);
+
+  int fd = __open64_nocancel (startp,
+			      O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW,
+			      DEFFILEMODE);
+  if (fd == -1)
+    return;
+
+  _dl_dprintf (fd, "{\n  \"time_unit\": \"%s\",\n"
+	       "  \"relocations\": %lu,\n"
+	       "  \"cached_relocations\": %lu,\n"
+	       "  \"objects\": [",
+	       HP_TIMING_INLINE ? "cycles" : "none",
+	       GL(dl_num_relocations), GL(dl_num_cache_relocations));
+
+  const char *sep = "\n";
+  for (Lmid_t ns = 0; ns < GL(dl_nns); ++ns)
+    for (struct link_map *l = GL(dl_ns)[ns]._ns_loaded; l != NULL;
+	 l = l->l_next)
+      if (l->l_startup_profile != NULL)
+	{
+	  _dl_dprintf (fd, "%s", sep);
+	  write_object (fd, l);
+	  sep = ",\n";
+	}
+
+  _dl_dprintf (fd, "\n  ]\n}\n");
+  __close_nocancel (fd);
+}
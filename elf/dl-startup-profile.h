@@ -0,0 +1,108 @@
+/* Per-object profile of dynamic linker startup.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _DL_STARTUP_PROFILE_H
+#define _DL_STARTUP_PROFILE_H
+
+#include <hp-timing.h>
+#include <ldsodefs.h>
+
+/* If LD_STARTUP_PROFILE_OUTPUT is set, the dynamic linker records the
+   time spent in each phase of startup for every object loaded until
+   the constructors of the initial objects have run, and writes the
+   result as JSON.  Times are only measured on architectures with
+   inline hp-timing support (see rtld.c).  */
+
+struct dl_startup_profile
+{
+  /* Time spent locating and mapping the object.  */
+  hp_timing_t map_time;
+  /* Time spent in _dl_relocate_object, including ifunc_time.  */
+  hp_timing_t relocate_time;
+  /* Time spent in IFUNC resolvers called for relocations of the
+     object.  */
+  hp_timing_t ifunc_time;
+  /* Time spent in the ELF constructors of the object.  */
+  hp_timing_t init_time;
+  unsigned long int ifunc_calls;
+  /* Symbol lookups on behalf of the object, and the number of
+     DT_GNU_HASH chain entries inspected for them.  */
+  unsigned long int lookups;
+  unsigned long int hash_chain_steps;
+};
+
+#if defined SHARED && HP_TIMING_INLINE
+static inline void
+_dl_startup_profile_start (hp_timing_t *start)
+{
+  HP_TIMING_NOW (*start);
+}
+
+static inline void
+_dl_startup_profile_accum (hp_timing_t *sum, hp_timing_t start)
+{
+  hp_timing_t stop, diff;
+  HP_TIMING_NOW (stop);
+  HP_TIMING_DIFF (diff, start, stop);
+  HP_TIMING_ACCUM_NT (*sum, diff);
+}
+#else
+# define _dl_startup_profile_start(start) ((void) (start))
+# define _dl_startup_profile_accum(sum, start) ((void) (sum), (void) (start))
+#endif
+
+#ifdef SHARED
+/* Return the profile of L, or NULL if L is not being profiled.  */
+static inline struct dl_startup_profile *
+_dl_startup_profile (const struct link_map *l)
+{
+  return l->l_startup_profile;
+}
+
+/* Start profiling L, if the startup profile is being recorded.
+   Return the profile of L, or NULL.  */
+extern struct dl_startup_profile *_dl_startup_profile_add
+  (struct link_map *l) attribute_hidden;
+
+/* Write the startup profile and stop recording it.  */
+extern void _dl_startup_profile_write (void) attribute_hidden;
+#else
+# define _dl_startup_profile(l) ((struct dl_startup_profile *) NULL)
+#endif
+
+/* Call the IFUNC resolver at ADDR for a relocation in MAP.  */
+static inline ElfW(Addr)
+__attribute__ ((always_inline))
+_dl_startup_profile_ifunc (struct link_map *map, ElfW(Addr) addr)
+{
+#if defined SHARED && !defined RTLD_BOOTSTRAP
+  struct dl_startup_profile *profile = _dl_startup_profile (map);
+  if (__glibc_unlikely (profile != NULL))
+    {
+      hp_timing_t start;
+      _dl_startup_profile_start (&start);
+      addr = ((ElfW(Addr) (*) (void)) addr) ();
+      _dl_startup_profile_accum (&profile->ifunc_time, start);
+      ++profile->ifunc_calls;
+      return addr;
+    }
+#endif
+  return ((ElfW(Addr) (*) (void)) addr) ();
+}
+
+#endif /* _DL_STARTUP_PROFILE_H */
@@ -55,6 +55,7 @@ int _dl_debug_mask;
 int _dl_lazy;
 ElfW(Addr) _dl_use_load_bias = -2;
 int _dl_dynamic_weak;
+enum dso_sort_algorithm _dl_dso_sort_algo;
 
 /* If nonzero print warnings about problematic situations.  */
 int _dl_verbose;
@@ -394,6 +395,9 @@ _dl_non_dynamic_init (void)
   if (_dl_platform != NULL)
     _dl_platformlen = strlen (_dl_platform);
 
+  /* Select the algorithm for sorting dependencies.  */
+  _dl_sort_maps_init ();
+
   if (_dl_phdr != NULL)
     for (const ElfW(Phdr) *ph = _dl_phdr; ph < &_dl_phdr[_dl_phnum]; ++ph)
       switch (ph->p_type)
@@ -412,6 +416,9 @@ _dl_non_dynamic_init (void)
   /* Setup relro on the binary itself.  */
   if (_dl_main_map.l_relro_size != 0)
     _dl_protect_relro (&_dl_main_map);
+
+  /* Set up the data for _dl_find_object.  */
+  _dl_find_object_init ();
 }
 
 #ifdef DL_SYSINFO_IMPLEMENTATION
@@ -481,6 +481,11 @@ _dl_resize_dtv (dtv_t *dtv)
     = atomic_load_acquire (&GL(dl_tls_max_dtv_idx)) + DTV_SURPLUS;
   size_t oldsize = dtv[-1].counter;
 
+  /* Grow geometrically, so that a thread does not have to resize its
+     dtv again for each of a series of dlopen calls.  */
+  if (newsize < 2 * oldsize)
+    newsize = 2 * oldsize;
+
   if (dtv == GL(dl_initial_dtv))
     {
       /* This is the initial dtv that was either statically allocated in
@@ -698,6 +703,21 @@ allocate_and_init (struct link_map *map)
 }
 
 
+/* Return the address of the static TLS block of MAP in the current
+   thread.  */
+static inline void *
+static_tls_address (struct link_map *map)
+{
+#if TLS_TCB_AT_TP
+  return (char *) THREAD_SELF - map->l_tls_offset;
+#elif TLS_DTV_AT_TP
+  return (char *) THREAD_SELF + map->l_tls_offset + TLS_PRE_TCB_SIZE;
+#else
+# error "Either TLS_TCB_AT_TP or TLS_DTV_AT_TP must be defined"
+#endif
+}
+
+
 struct link_map *
 _dl_update_slotinfo (unsigned long int req_modid)
 {
@@ -781,9 +801,17 @@ _dl_update_slotinfo (unsigned long int req_modid)
 	      /* XXX Ideally we will at some point create a memory
 		 pool.  */
 	      free (dtv[modid].pointer.to_free);
-	      dtv[modid].pointer.val = TLS_DTV_UNALLOCATED;
 	      dtv[modid].pointer.to_free = NULL;
 
+	      /* The static TLS block of an object which was placed
+		 there when it was loaded has been initialized before
+		 the object became usable, so the entry can point to it
+		 right away.  */
+	      if (map != NULL && map->l_tls_static_eager)
+		dtv[modid].pointer.val = static_tls_address (map);
+	      else
+		dtv[modid].pointer.val = TLS_DTV_UNALLOCATED;
+
 	      if (modid == req_modid)
 		the_map = map;
 	    }
@@ -820,6 +848,17 @@ tls_get_addr_tail (GET_ADDR_ARGS, dtv_t *dtv, struct link_map *the_map)
       the_map = listp->slotinfo[idx].map;
     }
 
+  /* Static TLS which was reserved when the object was loaded does not
+     change, and it was initialized in all threads before the object
+     could be used.  No locking is needed.  */
+  if (the_map->l_tls_static_eager)
+    {
+      void *p = static_tls_address (the_map);
+      dtv[GET_ADDR_MODULE].pointer.to_free = NULL;
+      dtv[GET_ADDR_MODULE].pointer.val = p;
+      return (char *) p + GET_ADDR_OFFSET;
+    }
+
   /* Make sure that, if a dlopen running in parallel forces the
      variable into static storage, we'll wait until the address in the
      static TLS block is set up, and use that.  If we're undecided
@@ -836,13 +875,7 @@ tls_get_addr_tail (GET_ADDR_ARGS, dtv_t *dtv, struct link_map *the_map)
       else if (__glibc_likely (the_map->l_tls_offset
 			       != FORCED_DYNAMIC_TLS_OFFSET))
 	{
-#if TLS_TCB_AT_TP
-	  void *p = (char *) THREAD_SELF - the_map->l_tls_offset;
-#elif TLS_DTV_AT_TP
-	  void *p = (char *) THREAD_SELF + the_map->l_tls_offset + TLS_PRE_TCB_SIZE;
-#else
-# error "Either TLS_TCB_AT_TP or TLS_DTV_AT_TP must be defined"
-#endif
+	  void *p = static_tls_address (the_map);
 	  __rtld_lock_unlock_recursive (GL(dl_load_lock));
 
 	  dtv[GET_ADDR_MODULE].pointer.to_free = NULL;
@@ -894,7 +927,10 @@ __tls_get_addr (GET_ADDR_ARGS)
 {
   dtv_t *dtv = THREAD_DTV ();
 
-  if (__glibc_unlikely (dtv[0].counter != GL(dl_tls_generation)))
+  /* The generation counter is updated by dlopen and dlclose without
+     synchronizing with this function.  */
+  if (__glibc_unlikely (dtv[0].counter
+			!= atomic_load_relaxed (&GL(dl_tls_generation))))
     return update_get_addr (GET_ADDR_PARAM);
 
   void *p = dtv[GET_ADDR_MODULE].pointer.val;
@@ -46,6 +46,43 @@ int _dl_try_allocate_static_tls (struct link_map *map, bool optional)
   attribute_hidden;
 
 #include <elf.h>
+#include <limits.h>
+
+#ifndef ELF_DYNAMIC_DO_RELR
+/* Apply the DT_RELR relative relocations of MAP.  The table is a
+   sequence of address and bitmap entries.  An even entry is the address
+   of a word to relocate.  An odd entry is a bitmap describing the next
+   CHAR_BIT * sizeof (ElfW(Relr)) - 1 words following those covered by
+   the previous entry; bit N + 1 is set if word N needs relocating.
+   Nothing needs to be done if the object is loaded at its link-time
+   address.  */
+# define ELF_DYNAMIC_DO_RELR(map)					      \
+  do {									      \
+    ElfW(Addr) l_addr = (map)->l_addr, *where = 0;			      \
+    const ElfW(Relr) *r, *end;						      \
+    if ((map)->l_info[DT_RELR] == NULL || l_addr == 0)			      \
+      break;								      \
+    r = (const ElfW(Relr) *) D_PTR ((map), l_info[DT_RELR]);		      \
+    end = (const ElfW(Relr) *) ((const char *) r			      \
+				 + (map)->l_info[DT_RELRSZ]->d_un.d_val);     \
+    for (; r < end; r++)						      \
+      {									      \
+	ElfW(Relr) entry = *r;						      \
+	if ((entry & 1) == 0)						      \
+	  {								      \
+	    where = (ElfW(Addr) *) (l_addr + entry);			      \
+	    *where++ += l_addr;						      \
+	  }								      \
+	else								      \
+	  {								      \
+	    for (long int i = 0; (entry >>= 1) != 0; i++)		      \
+	      if ((entry & 1) != 0)					      \
+		where[i] += l_addr;					      \
+	    where += CHAR_BIT * sizeof (ElfW(Relr)) - 1;		      \
+	  }								      \
+      }									      \
+  } while (0)
+#endif
 
 #ifdef RESOLVE_MAP
 /* We pass reloc_addr as a pointer to void, as opposed to a pointer to
@@ -190,12 +227,25 @@ elf_machine_lazy_rel (struct link_map *map,
 #  define ELF_DYNAMIC_DO_RELA(map, lazy, skip_ifunc) /* Nothing to do.  */
 # endif
 
+/* The relative relocations of ld.so have already been applied during
+   bootstrap, so they must not be applied again when ld.so is relocated
+   with the other objects.  The same holds for objects whose relative
+   relocations were applied by _dl_relocate_relr_parallel.  */
+# if defined RTLD_BOOTSTRAP || !defined SHARED
+#  define ELF_DYNAMIC_DO_RELR_P(map) 1
+# else
+#  define ELF_DYNAMIC_DO_RELR_P(map) \
+  ((map) != &GL(dl_rtld_map) && !(map)->l_relr_done)
+# endif
+
 /* This can't just be an inline function because GCC is too dumb
    to inline functions containing inlines themselves.  */
 # define ELF_DYNAMIC_RELOCATE(map, lazy, consider_profile, skip_ifunc) \
   do {									      \
     int edr_lazy = elf_machine_runtime_setup ((map), (lazy),		      \
 					      (consider_profile));	      \
+    if (ELF_DYNAMIC_DO_RELR_P (map))					      \
+      ELF_DYNAMIC_DO_RELR (map);					      \
     ELF_DYNAMIC_DO_REL ((map), edr_lazy, skip_ifunc);			      \
     ELF_DYNAMIC_DO_RELA ((map), edr_lazy, skip_ifunc);			      \
   } while (0)
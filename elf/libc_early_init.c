@@ -21,6 +21,7 @@
 #include <libc-early-init.h>
 #include <libc-internal.h>
 #include <lowlevellock.h>
+#include <rseq-internal.h>
 #include <sys/single_threaded.h>
 
 #ifdef SHARED
@@ -40,6 +41,11 @@ __libc_early_init (_Bool initial)
   __libc_initial = initial;
 #endif
 
+  /* Only the initial libc registers the rseq area of the main thread;
+     a libc loaded with dlmopen shares it.  */
+  if (initial)
+    rseq_register_main_thread ();
+
 #if ENABLE_ELISION_SUPPORT
   __lll_elision_init ();
 #endif
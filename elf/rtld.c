@@ -51,6 +51,9 @@
 #include <list.h>
 #include <gnu/lib-names.h>
 #include <dl-tunables.h>
+#include <dl-startup-profile.h>
+#include <dl-ifunc-cache.h>
+#include <dl-hugepages.h>
 
 #include <assert.h>
 
@@ -1160,6 +1163,12 @@ dl_main (const ElfW(Phdr) *phdr,
   /* Process the environment variable which control the behaviour.  */
   process_envvars (&state);
 
+  /* Select the algorithm for sorting dependencies.  */
+  _dl_sort_maps_init ();
+
+  /* Load the IFUNC cache before the first object is relocated.  */
+  _dl_ifunc_cache_init ();
+
 #ifndef HAVE_INLINED_SYSCALLS
   /* Set up a flag which tells we are just starting.  */
   _dl_starting_up = 1;
@@ -1653,6 +1662,20 @@ dl_main (const ElfW(Phdr) *phdr,
 
       /* Set up our cache of pointers into the hash table.  */
       _dl_setup_hash (main_map);
+
+      /* The kernel has mapped the program, so ld.so can only ask for
+	 huge pages for its code.  This only has an effect if the kernel
+	 has honored the segment alignment when choosing the load
+	 address.  */
+      size_t hugepage = _dl_hugepage_size ();
+      if (__glibc_unlikely (hugepage != 0))
+	for (const ElfW(Phdr) *ph = main_map->l_phdr;
+	     ph < &main_map->l_phdr[main_map->l_phnum]; ++ph)
+	  if (ph->p_type == PT_LOAD && (ph->p_flags & PF_X) != 0
+	      && ph->p_align >= hugepage)
+	    _dl_hugepage_advise (main_map->l_addr + ph->p_vaddr,
+				 main_map->l_addr + ph->p_vaddr + ph->p_filesz,
+				 hugepage);
     }
 
   if (__glibc_unlikely (state.mode == rtld_mode_verify))
@@ -1671,6 +1694,11 @@ dl_main (const ElfW(Phdr) *phdr,
       _exit (has_interp ? 0 : 2);
     }
 
+  /* The main program and the dynamic linker itself have already been
+     mapped, but their relocation is still to be profiled.  */
+  _dl_startup_profile_add (main_map);
+  _dl_startup_profile_add (&GL(dl_rtld_map));
+
   struct link_map **first_preload = &GL(dl_rtld_map).l_next;
   /* Set up the data structures for the system-supplied DSO early,
      so they can influence _dl_init_paths.  */
@@ -2321,6 +2349,15 @@ dl_main (const ElfW(Phdr) *phdr,
   /* Now set up the variable which helps the assembler startup code.  */
   GL(dl_ns)[LM_ID_BASE]._ns_main_searchlist = &main_map->l_searchlist;
 
+  /* Optionally let symbol lookups in the global scope skip the objects
+     which do not define the symbol.  */
+  _dl_scope_summary_init (main_map);
+
+  /* Make the initial objects available to _dl_find_object.  */
+  if (!_dl_find_object_update ())
+    _dl_fatal_printf ("Fatal glibc error: cannot allocate memory for"
+		      " the object address table\n");
+
   /* Save the information about the original global scope list since
      we need it in the memory handling later.  */
   GLRO(dl_initial_searchlist) = *GL(dl_ns)[LM_ID_BASE]._ns_main_searchlist;
@@ -2397,6 +2434,20 @@ dl_main (const ElfW(Phdr) *phdr,
 
       RTLD_TIMING_VAR (start);
       rtld_timer_start (&start);
+
+#if HAVE_TUNABLES
+      /* The relative relocations of the objects do not depend on each
+	 other and can be applied on several threads up front.  */
+      _dl_relocate_relr_parallel
+	(main_map, TUNABLE_GET_FULL (glibc, rtld, reloc_threads, int32_t,
+				     NULL));
+#endif
+
+      /* The global scope does not change while the initial set of
+	 objects is relocated, so the results of symbol lookups can be
+	 shared between these objects.  */
+      _dl_lookup_cache_init (main_map);
+
       unsigned i = main_map->l_searchlist.r_nlist;
       while (i-- > 0)
 	{
@@ -2423,6 +2474,8 @@ dl_main (const ElfW(Phdr) *phdr,
 	  if (l->l_tls_blocksize != 0 && tls_init_tp_called)
 	    _dl_add_to_slotinfo (l, true);
 	}
+
+      _dl_lookup_cache_fini ();
       rtld_timer_stop (&relocate_time, start);
 
       /* Now enable profiling if needed.  Like the previous call,
@@ -2484,6 +2537,9 @@ dl_main (const ElfW(Phdr) *phdr,
       rtld_timer_accum (&relocate_time, start);
     }
 
+  /* Store the IFUNC resolver results for the next process.  */
+  _dl_ifunc_cache_write ();
+
   /* Relocation is complete.  Perform early libc initialization.  This
      is the initial libc, even if audit modules have been loaded with
      other libcs.  */
@@ -2820,6 +2876,14 @@ process_envvars (struct dl_main_state *state)
 	    state->mode = rtld_mode_trace;
 	  break;
 
+	case 22:
+	  /* Where to write the startup profile.  */
+	  if (!__libc_enable_secure
+	      && memcmp (envline, "STARTUP_PROFILE_OUTPUT", 22) == 0
+	      && envline[23] != '\0')
+	    GL(dl_startup_profile_output) = &envline[23];
+	  break;
+
 	  /* We might have some extra environment variable to handle.  This
 	     is tricky due to the pre-processing of the length of the name
 	     in the switch statement here.  The code here assumes that added
@@ -0,0 +1,91 @@
+/* Test that PLT bindings are stored in the GOT while auditing.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <dlfcn.h>
+#include <ldsodefs.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/xdlfcn.h>
+
+extern int tst_audit17mod_func (int);
+
+/* On these architectures, a lazily bound PLT entry jumps through a GOT
+   slot, and the dynamic linker stores the address of the target
+   function there.  Other architectures patch the PLT code or use
+   function descriptors.  */
+#if defined __x86_64__ || defined __i386__ || defined __aarch64__ \
+    || defined __arm__ || defined __s390__ || defined __riscv
+# define GOT_HOLDS_TARGET 1
+#else
+# define GOT_HOLDS_TARGET 0
+#endif
+
+/* Return the GOT slot which the PLT relocation of NAME in MAP
+   patches.  */
+static ElfW(Addr) *
+find_plt_slot (struct link_map *map, const char *name)
+{
+  TEST_VERIFY_EXIT (map->l_info[DT_JMPREL] != NULL);
+  const ElfW(Sym) *symtab = (const void *) D_PTR (map, l_info[DT_SYMTAB]);
+  const char *strtab = (const void *) D_PTR (map, l_info[DT_STRTAB]);
+  uintptr_t start = D_PTR (map, l_info[DT_JMPREL]);
+  uintptr_t end = start + map->l_info[DT_PLTRELSZ]->d_un.d_val;
+  size_t entsize = (map->l_info[DT_PLTREL]->d_un.d_val == DT_RELA
+		    ? sizeof (ElfW(Rela)) : sizeof (ElfW(Rel)));
+
+  /* r_offset and r_info are at the same place in both types.  */
+  for (uintptr_t p = start; p < end; p += entsize)
+    {
+      const ElfW(Rel) *r = (const ElfW(Rel) *) p;
+      if (strcmp (strtab + symtab[ELFW(R_SYM) (r->r_info)].st_name,
+		  name) == 0)
+	return (ElfW(Addr) *) (map->l_addr + r->r_offset);
+    }
+  FAIL_EXIT1 ("no PLT relocation for %s", name);
+}
+
+static int
+do_test (void)
+{
+  ElfW(Addr) *slot = NULL;
+  ElfW(Addr) target = 0;
+  if (GOT_HOLDS_TARGET)
+    {
+      struct link_map *main_map = xdlopen (NULL, RTLD_LAZY);
+      slot = find_plt_slot (main_map, "tst_audit17mod_func");
+      void *mod = xdlopen ("tst-audit17mod.so", RTLD_LAZY | RTLD_NOLOAD);
+      target = (ElfW(Addr)) xdlsym (mod, "tst_audit17mod_func");
+
+      /* The function has not been called yet, so it is not bound.  */
+      TEST_VERIFY (*slot != target);
+    }
+
+  /* The first call is bound lazily and reported to the auditor, which
+     checks that this happens only once.  With no la_pltenter or
+     la_pltexit callbacks, the binding must be stored in the GOT, so
+     that the later calls do not enter the dynamic linker at all.  */
+  for (int i = 0; i < 10; ++i)
+    {
+      TEST_COMPARE (tst_audit17mod_func (i), i + 17);
+      if (GOT_HOLDS_TARGET)
+	TEST_VERIFY (*slot == target);
+    }
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,86 @@
+/* Audit module for tst-audit17.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <link.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/* This module deliberately does not define la_pltenter or la_pltexit,
+   so the dynamic linker is expected to store the bindings in the GOT
+   after reporting them.  tst-audit17 checks the GOT, and this module
+   checks that each binding is reported once.  */
+
+static unsigned int symbind_calls;
+
+unsigned int
+la_version (unsigned int version)
+{
+  return version;
+}
+
+unsigned int
+la_objopen (struct link_map *l, Lmid_t lmid, uintptr_t *cookie)
+{
+  *cookie = l->l_name[0] == '\0';
+  return LA_FLG_BINDTO | LA_FLG_BINDFROM;
+}
+
+static uintptr_t
+symbind (uintptr_t value, const char *symname)
+{
+  if (strcmp (symname, "tst_audit17mod_func") == 0)
+    {
+      ++symbind_calls;
+      if (symbind_calls > 1)
+	{
+	  printf ("error: tst_audit17mod_func bound %u times\n",
+		  symbind_calls);
+	  fflush (stdout);
+	  _exit (1);
+	}
+    }
+  return value;
+}
+
+uintptr_t
+la_symbind32 (Elf32_Sym *sym, unsigned int ndx, uintptr_t *refcook,
+	      uintptr_t *defcook, unsigned int *flags, const char *symname)
+{
+  return symbind (sym->st_value, symname);
+}
+
+uintptr_t
+la_symbind64 (Elf64_Sym *sym, unsigned int ndx, uintptr_t *refcook,
+	      uintptr_t *defcook, unsigned int *flags, const char *symname)
+{
+  return symbind (sym->st_value, symname);
+}
+
+unsigned int
+la_objclose (uintptr_t *cookie)
+{
+  /* All calls have been made when the objects are closed.  */
+  if (*cookie && symbind_calls != 1)
+    {
+      printf ("error: tst_audit17mod_func bound %u times\n", symbind_calls);
+      fflush (stdout);
+      _exit (1);
+    }
+  return 0;
+}
@@ -0,0 +1,102 @@
+/* Test the string hash functions of <poly-hash.h>.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <poly-hash.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/next_to_fault.h>
+
+/* Longest key tested.  Each length is tested at every alignment
+   modulo 4.  */
+#define MAX_LEN 100
+
+/* Compute the hash one byte at a time.  */
+static uint32_t
+reference_hash (uint32_t h, const unsigned char *s, size_t len, uint32_t m)
+{
+  for (size_t i = 0; i < len; ++i)
+    h = h * m + s[i];
+  return h;
+}
+
+/* Check the multipliers used in glibc.  They have to be constants in
+   the calls of the inline functions.  */
+static void
+check_key (const unsigned char *key, size_t len, uint32_t init,
+	   bool is_string)
+{
+  TEST_COMPARE (poly_hash_bytes (init, key, len, 33),
+		reference_hash (init, key, len, 33));
+  TEST_COMPARE (poly_hash_bytes (init, key, len, 65599),
+		reference_hash (init, key, len, 65599));
+
+  /* KEY contains no null byte, so it can be hashed as a string if it
+     is terminated.  */
+  if (is_string)
+    {
+      TEST_COMPARE (poly_hash_string (init, (const char *) key, 33),
+		    reference_hash (init, key, len, 33));
+      TEST_COMPARE (poly_hash_string (init, (const char *) key, 65599),
+		    reference_hash (init, key, len, 65599));
+    }
+}
+
+static int
+do_test (void)
+{
+  static const uint32_t inits[] = { 0, 5381, 0xffffffff };
+
+  /* The keys end just before an inaccessible page, so reading past
+     the terminating null byte or past LEN bytes faults.  */
+  struct support_next_to_fault ntf
+    = support_next_to_fault_allocate (MAX_LEN + 3 + 1);
+
+  /* Fill the buffer with all non-null byte values, including those
+     which are negative as char.  */
+  for (size_t i = 0; i < ntf.length; ++i)
+    ntf.buffer[i] = 1 + i * 37 % 255;
+
+  for (size_t len = 0; len <= MAX_LEN; ++len)
+    for (size_t align = 0; align < 4; ++align)
+      {
+	unsigned char *end = (unsigned char *) ntf.buffer + ntf.length;
+	unsigned char *key = end - 1 - len - align;
+	unsigned char saved = key[len];
+	for (size_t i = 0; i < sizeof (inits) / sizeof (inits[0]); ++i)
+	  {
+	    /* As a byte array ending at the page boundary.  */
+	    check_key (end - len, len, inits[i], false);
+	    /* As a string at every alignment.  */
+	    key[len] = '\0';
+	    check_key (key, len, inits[i], true);
+	    key[len] = saved;
+	  }
+      }
+
+  /* The null string terminated right before the inaccessible page.  */
+  ntf.buffer[ntf.length - 1] = '\0';
+  TEST_COMPARE (poly_hash_string (5381, &ntf.buffer[ntf.length - 1], 33),
+		5381u);
+
+  support_next_to_fault_free (&ntf);
+  return 0;
+}
+
+#include <support/test-driver.c>
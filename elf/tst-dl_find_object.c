@@ -0,0 +1,161 @@
+/* Basic tests for _dl_find_object.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <dlfcn.h>
+#include <link.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <support/check.h>
+#include <support/xdlfcn.h>
+#include <support/xthread.h>
+
+/* Information about the object containing an address, as found by
+   dl_iterate_phdr.  */
+struct phdr_result
+{
+  uintptr_t address;
+  bool found;
+  void *eh_frame;
+};
+
+static int
+phdr_callback (struct dl_phdr_info *info, size_t size, void *closure)
+{
+  struct phdr_result *result = closure;
+  bool inside = false;
+  void *eh_frame = NULL;
+  for (int i = 0; i < info->dlpi_phnum; ++i)
+    {
+      const ElfW(Phdr) *ph = &info->dlpi_phdr[i];
+      if (ph->p_type == PT_LOAD
+	  && result->address >= info->dlpi_addr + ph->p_vaddr
+	  && result->address < info->dlpi_addr + ph->p_vaddr + ph->p_memsz)
+	inside = true;
+      else if (ph->p_type == PT_GNU_EH_FRAME)
+	eh_frame = (void *) (info->dlpi_addr + ph->p_vaddr);
+    }
+  if (inside)
+    {
+      result->found = true;
+      result->eh_frame = eh_frame;
+      return 1;
+    }
+  return 0;
+}
+
+/* Check that _dl_find_object reports the same object for ADDRESS as
+   dladdr1 and dl_iterate_phdr.  */
+static void
+check (void *address, const char *what)
+{
+  Dl_info info;
+  struct link_map *expected;
+  if (dladdr1 (address, &info, (void **) &expected, RTLD_DL_LINKMAP) == 0)
+    FAIL_EXIT1 ("dladdr1 failed for %s", what);
+
+  struct phdr_result phdr = { .address = (uintptr_t) address };
+  dl_iterate_phdr (phdr_callback, &phdr);
+  TEST_VERIFY_EXIT (phdr.found);
+
+  struct dl_find_object dlfo;
+  if (_dl_find_object (address, &dlfo) != 0)
+    FAIL_EXIT1 ("_dl_find_object failed for %s", what);
+  TEST_VERIFY (dlfo.dlfo_flags == 0);
+  TEST_VERIFY (dlfo.dlfo_link_map == expected);
+  TEST_VERIFY (dlfo.dlfo_map_start <= address);
+  TEST_VERIFY (address < dlfo.dlfo_map_end);
+  TEST_VERIFY (dlfo.dlfo_eh_frame == phdr.eh_frame);
+  printf ("info: %s: %p in [%p, %p), eh_frame %p\n", what, address,
+	  dlfo.dlfo_map_start, dlfo.dlfo_map_end, dlfo.dlfo_eh_frame);
+}
+
+static void
+main_function (void)
+{
+}
+
+/* Addresses checked concurrently with dlopen and dlclose.  */
+static void *stable_addresses[3];
+static atomic_bool stop;
+
+static void *
+lookup_thread (void *closure)
+{
+  struct dl_find_object expected[array_length (stable_addresses)];
+  for (size_t i = 0; i < array_length (stable_addresses); ++i)
+    TEST_COMPARE (_dl_find_object (stable_addresses[i], &expected[i]), 0);
+
+  while (!atomic_load_explicit (&stop, memory_order_relaxed))
+    for (size_t i = 0; i < array_length (stable_addresses); ++i)
+      {
+	struct dl_find_object dlfo;
+	TEST_COMPARE (_dl_find_object (stable_addresses[i], &dlfo), 0);
+	TEST_VERIFY (dlfo.dlfo_link_map == expected[i].dlfo_link_map);
+	TEST_VERIFY (dlfo.dlfo_map_start == expected[i].dlfo_map_start);
+	TEST_VERIFY (dlfo.dlfo_eh_frame == expected[i].dlfo_eh_frame);
+      }
+  return NULL;
+}
+
+static int
+do_test (void)
+{
+  check (main_function, "main program");
+  check (&stop, "main program data");
+  check (printf, "printf");
+  check (xdlsym (RTLD_DEFAULT, "_r_debug"), "ld.so");
+
+  /* Addresses which do not belong to any object.  */
+  struct dl_find_object dlfo;
+  TEST_COMPARE (_dl_find_object (NULL, &dlfo), -1);
+  int local;
+  TEST_COMPARE (_dl_find_object (&local, &dlfo), -1);
+
+  void *mod = xdlopen ("tst-dl_find_object-mod.so", RTLD_NOW);
+  void *mod_function = xdlsym (mod, "mod_function");
+  check (mod_function, "module");
+  check (xdlsym (mod, "mod_data"), "module data");
+  xdlclose (mod);
+  TEST_COMPARE (_dl_find_object (mod_function, &dlfo), -1);
+
+  /* Lookups for other objects must not be disturbed by concurrent
+     dlopen and dlclose.  */
+  stable_addresses[0] = main_function;
+  stable_addresses[1] = printf;
+  stable_addresses[2] = &stop;
+  pthread_t threads[4];
+  for (size_t i = 0; i < array_length (threads); ++i)
+    threads[i] = xpthread_create (NULL, lookup_thread, NULL);
+  for (int i = 0; i < 200; ++i)
+    {
+      mod = xdlopen ("tst-dl_find_object-mod.so", RTLD_NOW);
+      mod_function = xdlsym (mod, "mod_function");
+      TEST_COMPARE (_dl_find_object (mod_function, &dlfo), 0);
+      xdlclose (mod);
+    }
+  atomic_store_explicit (&stop, true, memory_order_relaxed);
+  for (size_t i = 0; i < array_length (threads); ++i)
+    xpthread_join (threads[i]);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
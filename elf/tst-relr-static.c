@@ -0,0 +1 @@
+#include "tst-relr.c"
@@ -0,0 +1,57 @@
+/* Test DT_RELR relocations applied by glibc.rtld.reloc_threads.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The executable and both modules use DT_RELR, so the dynamic linker
+   applies their relative relocations on several threads before the
+   other relocations.  */
+
+#include <array_length.h>
+#include <stddef.h>
+#include <support/check.h>
+
+extern void *relr_threads_mod1[64];
+extern void *relr_threads_mod2[64];
+extern int *relr_threads_mod1_target (void);
+extern int *relr_threads_mod2_target (void);
+
+static int o;
+void *arr[] = { &o, NULL, &o, &o };
+
+static void
+check_module (void **array, int *target)
+{
+  /* Every eight words follow the pattern of ROW in the modules.  */
+  static const unsigned char row[] = { 1, 1, 0, 1, 0, 0, 0, 1 };
+  for (size_t i = 0; i < 64; i++)
+    TEST_VERIFY (array[i] == (row[i % array_length (row)] ? target : NULL));
+}
+
+static int
+do_test (void)
+{
+  check_module (relr_threads_mod1, relr_threads_mod1_target ());
+  check_module (relr_threads_mod2, relr_threads_mod2_target ());
+  TEST_VERIFY (arr[0] == &o);
+  TEST_VERIFY (arr[1] == NULL);
+  TEST_VERIFY (arr[2] == &o);
+  TEST_VERIFY (arr[3] == &o);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
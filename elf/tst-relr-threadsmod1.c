@@ -0,0 +1,33 @@
+/* Module with DT_RELR relocations for tst-relr-threads.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stddef.h>
+
+static int o;
+
+#define ROW &o, &o, NULL, &o, NULL, NULL, NULL, &o
+void *relr_threads_mod1[] =
+{
+  ROW, ROW, ROW, ROW, ROW, ROW, ROW, ROW
+};
+
+int *
+relr_threads_mod1_target (void)
+{
+  return &o;
+}
@@ -0,0 +1,82 @@
+/* Test DT_RELR relative relocations.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <link.h>
+#include <stdbool.h>
+#include <support/check.h>
+
+static int o, x;
+
+/* A mix of relocated and non-relocated words, so that the linker has to
+   use both address and bitmap entries, including bitmaps which span more
+   than one entry.  */
+#define E0 NULL
+#define E1 &o
+#define E2 &x
+#define ROW E1, E1, E0, E1, E2, E0, E0, E1
+void *arr[] =
+{
+  ROW, ROW, ROW, ROW, ROW, ROW, ROW, ROW,
+  ROW, ROW, ROW, ROW, ROW, ROW, ROW, ROW,
+  E0, E0, E0, E0, E0, E0, E0, E0,
+  E0, E0, E0, E0, E0, E0, E0, E0,
+  E0, E0, E0, E0, E0, E0, E0, E0,
+  E0, E0, E0, E0, E0, E0, E0, E0,
+  E0, E0, E0, E0, E0, E0, E0, E0,
+  E0, E0, E0, E0, E0, E0, E0, E0,
+  E0, E0, E0, E0, E0, E0, E0, E0,
+  E0, E0, E0, E0, E0, E0, E0, E0,
+  ROW, E2, E1
+};
+void *p = &x;
+static void *const expected_row[] = { ROW };
+
+/* Undefined in non-PIE static executables.  */
+extern ElfW(Dyn) _DYNAMIC[] __attribute__ ((weak));
+
+static int
+do_test (void)
+{
+  /* If the executable has a dynamic section, check that the relative
+     relocations have actually been packed.  */
+  if (_DYNAMIC != NULL)
+    {
+      bool found = false;
+      for (ElfW(Dyn) *d = _DYNAMIC; d->d_tag != DT_NULL; d++)
+	if (d->d_tag == DT_RELR)
+	  found = true;
+      TEST_VERIFY (found);
+    }
+
+  size_t row = array_length (expected_row);
+  for (size_t i = 0; i < array_length (arr) - row - 2; i++)
+    if (i < 16 * row)
+      TEST_VERIFY (arr[i] == expected_row[i % row]);
+    else
+      TEST_VERIFY (arr[i] == NULL);
+  for (size_t i = 0; i < row; i++)
+    TEST_VERIFY (arr[array_length (arr) - row - 2 + i] == expected_row[i]);
+  TEST_VERIFY (arr[array_length (arr) - 2] == &x);
+  TEST_VERIFY (arr[array_length (arr) - 1] == &o);
+  TEST_VERIFY (p == &x);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
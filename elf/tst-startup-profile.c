@@ -0,0 +1,81 @@
+/* Test the startup profile written by the dynamic linker.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/xstdio.h>
+
+/* The test runs with LD_STARTUP_PROFILE_OUTPUT=PROFILE_OUTPUT.  The
+   dynamic linker appends the process ID to the file name.  The test
+   driver may run do_test in a subprocess.  */
+
+static char contents[1 << 16];
+
+static void
+check_member (const char *member)
+{
+  char *pattern = xasprintf ("\"%s\": ", member);
+  if (strstr (contents, pattern) == NULL)
+    FAIL ("member %s not found", member);
+  free (pattern);
+}
+
+static int
+do_test (void)
+{
+  char *path = xasprintf ("%s.%d", PROFILE_OUTPUT, (int) getpid ());
+  if (access (path, F_OK) != 0)
+    {
+      free (path);
+      path = xasprintf ("%s.%d", PROFILE_OUTPUT, (int) getppid ());
+    }
+
+  FILE *fp = xfopen (path, "r");
+  size_t length = fread (contents, 1, sizeof (contents) - 1, fp);
+  TEST_VERIFY_EXIT (length > 0);
+  TEST_VERIFY_EXIT (length < sizeof (contents) - 1);
+  xfclose (fp);
+  printf ("info: %s:\n%s", path, contents);
+
+  TEST_COMPARE (contents[0], '{');
+  TEST_VERIFY (length >= 4 && strcmp (contents + length - 4, "]\n}\n") == 0);
+  check_member ("objects");
+  check_member ("relocations");
+  check_member ("map");
+  check_member ("relocate");
+  check_member ("ifunc");
+  check_member ("init");
+  check_member ("lookups");
+  check_member ("hash_chain_steps");
+
+  /* The main program, libc.so.6 and ld.so are listed.  */
+  TEST_VERIFY (strstr (contents, "tst-startup-profile\"") != NULL);
+  TEST_VERIFY (strstr (contents, "libc.so.6\"") != NULL);
+  TEST_VERIFY (strstr (contents, "ld-linux") != NULL
+	       || strstr (contents, "ld.so") != NULL
+	       || strstr (contents, "ld64.so") != NULL);
+
+  free (path);
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,32 @@
+/* Module with general dynamic TLS for tst-tls-eager.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+__thread int tls_var __attribute__ ((tls_model ("global-dynamic"))) = 42;
+__thread char tls_buf[64] __attribute__ ((tls_model ("global-dynamic")));
+
+int *
+get_tls_var (void)
+{
+  return &tls_var;
+}
+
+char *
+get_tls_buf (void)
+{
+  return tls_buf;
+}
@@ -0,0 +1,103 @@
+/* Test access to TLS in static TLS reserved by dlopen.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Objects loaded with dlopen have their TLS placed in the optional
+   static TLS surplus if it fits.  Check that the TLS blocks are
+   initialized in threads which existed before the dlopen call and in
+   threads created afterwards, and that repeatedly loading and unloading
+   the module works once the surplus is used up.  */
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/xdlfcn.h>
+#include <support/xthread.h>
+
+static int *(*get_tls_var) (void);
+static char *(*get_tls_buf) (void);
+static pthread_barrier_t barrier;
+
+/* Check the initial values in the current thread and modify them.
+   Return the address of the variable.  */
+static void *
+check_tls (void *closure)
+{
+  int *var = get_tls_var ();
+  TEST_COMPARE (*var, 42);
+  char *buf = get_tls_buf ();
+  for (int i = 0; i < 64; ++i)
+    TEST_COMPARE (buf[i], 0);
+  *var = 17;
+  memset (buf, 'x', 64);
+  TEST_VERIFY (get_tls_var () == var);
+  TEST_VERIFY (get_tls_buf () == buf);
+  return var;
+}
+
+static void *
+early_thread (void *closure)
+{
+  /* Wait until the module has been loaded.  */
+  xpthread_barrier_wait (&barrier);
+  return check_tls (NULL);
+}
+
+static void *
+load (void)
+{
+  void *handle = xdlopen ("tst-tls-eager-mod.so", RTLD_NOW);
+  get_tls_var = xdlsym (handle, "get_tls_var");
+  get_tls_buf = xdlsym (handle, "get_tls_buf");
+  return handle;
+}
+
+static int
+do_test (void)
+{
+  xpthread_barrier_init (&barrier, NULL, 2);
+  pthread_t early = xpthread_create (NULL, early_thread, NULL);
+
+  void *handle = load ();
+  xpthread_barrier_wait (&barrier);
+
+  void *main_var = check_tls (NULL);
+  void *early_var = xpthread_join (early);
+  pthread_t late = xpthread_create (NULL, check_tls, NULL);
+  void *late_var = xpthread_join (late);
+  TEST_VERIFY (main_var != early_var);
+  TEST_VERIFY (main_var != late_var);
+  TEST_VERIFY (early_var != late_var);
+  TEST_COMPARE (*(int *) main_var, 17);
+  xdlclose (handle);
+
+  /* The optional surplus is not returned by dlclose.  Later copies of
+     the module use dynamic TLS.  */
+  for (int i = 0; i < 100; ++i)
+    {
+      handle = load ();
+      check_tls (NULL);
+      xpthread_join (xpthread_create (NULL, check_tls, NULL));
+      xdlclose (handle);
+    }
+
+  xpthread_barrier_destroy (&barrier);
+  return 0;
+}
+
+#include <support/test-driver.c>
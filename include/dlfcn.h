@@ -92,6 +92,8 @@ extern void *_dl_sym (void *handle, const char *name, void *who);
 extern void *_dl_vsym (void *handle, const char *name, const char *version,
 		       void *who);
 
+rtld_hidden_proto (_dl_find_object)
+
 /* Helper function for <dlfcn.h> functions.  Runs the OPERATE function via
    _dl_catch_error.  Returns zero for success, nonzero for failure; and
    arranges for `dlerror' to return the error details.
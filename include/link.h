@@ -61,6 +61,26 @@ struct r_search_path_elem;
 /* Forward declaration.  */
 struct link_map;
 
+/* Summary of the symbols defined by the first NLIST objects of a
+   scope.  The objects are split into up to 64 groups of GROUP_SIZE
+   consecutive objects.  Bit G of a bucket is set if an object in group
+   G defines a symbol whose GNU hash selects the bucket.  A symbol is
+   hashed into two buckets, and only the groups set in both need to be
+   searched for it.  */
+struct r_scope_summary
+{
+  unsigned int nlist;
+  unsigned int group_size;
+  /* Shift applied to the hash for the second bucket.  */
+  unsigned int shift;
+  /* Number of buckets minus one.  */
+  uint32_t mask;
+  /* Groups which contain objects without a GNU hash table and must
+     always be searched.  */
+  uint64_t always;
+  uint64_t buckets[];
+};
+
 /* Structure to describe a single list of scope elements.  The lookup
    functions get passed an array of pointers to such structures.  */
 struct r_scope_elem
@@ -69,6 +89,9 @@ struct r_scope_elem
   struct link_map **r_list;
   /* Number of entries in the scope.  */
   unsigned int r_nlist;
+  /* Summary of the leading part of the scope which is never modified,
+     or NULL.  See _dl_scope_summary_init.  */
+  const struct r_scope_summary *r_summary;
 };
 
 
@@ -190,6 +213,9 @@ struct link_map
     unsigned int l_need_tls_init:1; /* Nonzero if GL(dl_init_static_tls)
 				       should be called on this link map
 				       when relocation finishes.  */
+    unsigned int l_tls_static_eager:1; /* Nonzero if the TLS block was
+					  placed in static TLS when the
+					  object was loaded.  */
     unsigned int l_auditing:1;	/* Nonzero if the DSO is used in auditing.  */
     unsigned int l_audit_any_plt:1; /* Nonzero if at least one audit module
 				       is interested in the PLT interception.*/
@@ -205,6 +231,13 @@ struct link_map
     unsigned int l_free_initfini:1; /* Nonzero if l_initfini can be
 				       freed, ie. not allocated with
 				       the dummy malloc in ld.so.  */
+    unsigned int l_relr_done:1; /* Nonzero if the DT_RELR relocations
+				   have already been applied.  */
+    unsigned int l_visited:1;   /* Used internally for map dependency
+				   graph traversal.  */
+    unsigned int l_map_used:1;  /* These two bits are used to carry the
+				   USED flag of _dl_sort_maps along
+				   with the map.  */
 
     /* NODELETE status of the map.  Only valid for maps of type
        lt_loaded.  Lazy binding sets l_nodelete_active directly,
@@ -340,6 +373,14 @@ struct link_map
     size_t l_relro_size;
 
     unsigned long long int l_serial;
+
+    /* Startup profile data, or NULL if the object is not profiled.  See
+       elf/dl-startup-profile.h.  */
+    struct dl_startup_profile *l_startup_profile;
+
+    /* Hash of the build ID of the object for the IFUNC cache, 0 if not
+       computed yet.  See elf/dl-ifunc-cache.c.  */
+    uint64_t l_ifunc_cache_key;
   };
 
 /* Information used by audit modules.  For most link maps, this data
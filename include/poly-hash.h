@@ -0,0 +1,95 @@
+/* Multiplicative string hash functions.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _POLY_HASH_H
+#define _POLY_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Several hash functions in glibc compute H = H * M + C for each byte C
+   of the key, modulo 2**32: the GNU symbol hash with M = 33 (DJB), and
+   the NSS and nscd hash with M = 65599 (sdbm).  Computed one byte at a
+   time, each step has to wait for the multiplication of the previous
+   one.  The functions below compute the same values for four bytes per
+   step as
+
+     H = H * M**4 + C0 * M**3 + C1 * M**2 + C2 * M + C3
+
+   where the products of the bytes are independent of each other and of
+   H.  M must be a constant, so that its powers are computed at compile
+   time.  */
+
+/* Return the hash of the LEN bytes at KEY, starting with the value H.  */
+static __always_inline uint32_t
+poly_hash_bytes (uint32_t h, const void *key, size_t len, const uint32_t m)
+{
+  const unsigned char *s = key;
+  const uint32_t m2 = m * m;
+  const uint32_t m3 = m2 * m;
+  const uint32_t m4 = m3 * m;
+
+  for (; len >= 4; len -= 4, s += 4)
+    h = h * m4 + s[0] * m3 + s[1] * m2 + s[2] * m + s[3];
+
+  switch (len)
+    {
+    case 3:
+      h = h * m3 + s[0] * m2 + s[1] * m + s[2];
+      break;
+    case 2:
+      h = h * m2 + s[0] * m + s[1];
+      break;
+    case 1:
+      h = h * m + s[0];
+      break;
+    }
+  return h;
+}
+
+/* Return the hash of the null-terminated string STR, starting with the
+   value H.  The terminating null byte is not part of the hash.  No byte
+   past it is read.  */
+static __always_inline uint32_t
+poly_hash_string (uint32_t h, const char *str, const uint32_t m)
+{
+  const unsigned char *s = (const unsigned char *) str;
+  const uint32_t m2 = m * m;
+  const uint32_t m3 = m2 * m;
+  const uint32_t m4 = m3 * m;
+
+  while (1)
+    {
+      uint32_t c0 = s[0];
+      if (c0 == 0)
+	return h;
+      uint32_t c1 = s[1];
+      if (c1 == 0)
+	return h * m + c0;
+      uint32_t c2 = s[2];
+      if (c2 == 0)
+	return h * m2 + c0 * m + c1;
+      uint32_t c3 = s[3];
+      if (c3 == 0)
+	return h * m3 + c0 * m2 + c1 * m + c2;
+      h = h * m4 + c0 * m3 + c1 * m2 + c2 * m + c3;
+      s += 4;
+    }
+}
+
+#endif /* poly-hash.h */
@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <search.h>
 #include <limits.h>
+#include <poly-hash.h>
 
 /* [Aho,Sethi,Ullman] Compilers: Principles, Techniques and Tools, 1986
    [Knuth]            The Art of Computer Programming, part 3 (6.4)  */
@@ -130,9 +131,9 @@ weak_alias (__hdestroy_r, hdestroy_r)
 
 /* This is the search function. It uses double hashing with open addressing.
    The argument item.key has to be a pointer to an zero terminated, most
-   probably strings of chars. The function for generating a number of the
-   strings is simple but fast. It can be replaced by a more complex function
-   like ajw (see [Aho,Sethi,Ullman]) if the needs are shown.
+   probably strings of chars. The number for the strings is computed with
+   the multiplicative hash of <poly-hash.h>, which depends on all
+   characters of the string.
 
    We use an trick to speed up the lookup. The table is created by hcreate
    with one more element available. This enables us to use the index zero
@@ -146,18 +147,10 @@ __hsearch_r (ENTRY item, ACTION action, ENTRY **retval,
 	     struct hsearch_data *htab)
 {
   unsigned int hval;
-  unsigned int count;
-  unsigned int len = strlen (item.key);
   unsigned int idx;
 
-  /* Compute an value for the given string. Perhaps use a better method. */
-  hval = len;
-  count = len;
-  while (count-- > 0)
-    {
-      hval <<= 4;
-      hval += item.key[count];
-    }
+  /* Compute an value for the given string.  */
+  hval = poly_hash_string (5381, item.key, 33);
   if (hval == 0)
     ++hval;
 
@@ -35,6 +35,7 @@
 #include <bits/types/res_state.h>
 #include <kernel-features.h>
 #include <tls-internal-struct.h>
+#include <sys/rseq.h>
 
 #ifndef TCB_ALIGNMENT
 # define TCB_ALIGNMENT	sizeof (double)
@@ -409,6 +410,10 @@ struct pthread
   /* Used on strsignal.  */
   struct tls_internal_t tls_state;
 
+  /* rseq area registered with the kernel at thread start, see
+     rseq-internal.h.  sched_getcpu reads the cpu_id field.  */
+  struct rseq rseq_area;
+
   /* This member must be last.  */
   char end_padding[];
 
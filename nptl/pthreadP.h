@@ -59,6 +59,15 @@ static inline short max_adaptive_count (void)
 #endif
 }
 
+static inline int max_sem_spin_count (void)
+{
+#if HAVE_TUNABLES
+  return __mutex_aconf.sem_spin_count;
+#else
+  return 0;
+#endif
+}
+
 
 /* Magic cookie representing robust mutex with dead owner.  */
 #define PTHREAD_MUTEX_INCONSISTENT	INT_MAX
@@ -32,6 +32,7 @@
 #include <kernel-features.h>
 #include <exit-thread.h>
 #include <default-sched.h>
+#include <rseq-internal.h>
 #include <futex-internal.h>
 #include <tls-setup.h>
 #include "libioP.h"
@@ -386,6 +387,10 @@ START_THREAD_DEFN
   /* Initialize pointers to locale data.  */
   __ctype_init ();
 
+  /* Register rseq area for the new thread, unless the initial thread
+     did not register one.  */
+  rseq_register_current_thread (pd, __rseq_size != 0);
+
 #ifndef __ASSUME_SET_ROBUST_LIST
   if (__set_robust_list_avail >= 0)
 #endif
@@ -29,6 +29,9 @@ struct mutex_config __mutex_aconf =
   /* The maximum number of times a thread should spin on the lock before
   calling into kernel to block.  */
   .spin_count = DEFAULT_ADAPTIVE_COUNT,
+  /* The maximum number of times sem_wait should retry grabbing a token
+  before registering as a waiter and blocking.  Zero disables spinning.  */
+  .sem_spin_count = 0,
 };
 
 static void
@@ -37,10 +40,18 @@ TUNABLE_CALLBACK (set_mutex_spin_count) (tunable_val_t *valp)
   __mutex_aconf.spin_count = (int32_t) (valp)->numval;
 }
 
+static void
+TUNABLE_CALLBACK (set_sem_spin_count) (tunable_val_t *valp)
+{
+  __mutex_aconf.sem_spin_count = (int32_t) (valp)->numval;
+}
+
 void
 __pthread_tunables_init (void)
 {
   TUNABLE_GET (mutex_spin_count, int32_t,
                TUNABLE_CALLBACK (set_mutex_spin_count));
+  TUNABLE_GET (sem_spin_count, int32_t,
+               TUNABLE_CALLBACK (set_sem_spin_count));
 }
 #endif
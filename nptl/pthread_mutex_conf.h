@@ -24,6 +24,7 @@
 struct mutex_config
 {
   int spin_count;
+  int sem_spin_count;
 };
 
 extern struct mutex_config __mutex_aconf attribute_hidden;
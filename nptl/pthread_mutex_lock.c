@@ -356,36 +356,10 @@ __pthread_mutex_lock_full (pthread_mutex_t *mutex)
 	    __asm ("" ::: "memory");
 	  }
 
-	oldval = mutex->__data.__lock;
-
-	/* Check whether we already hold the mutex.  */
-	if (__glibc_unlikely ((oldval & FUTEX_TID_MASK) == id))
-	  {
-	    if (kind == PTHREAD_MUTEX_ERRORCHECK_NP)
-	      {
-		/* We do not need to ensure ordering wrt another memory
-		   access.  */
-		THREAD_SETMEM (THREAD_SELF, robust_head.list_op_pending, NULL);
-		return EDEADLK;
-	      }
-
-	    if (kind == PTHREAD_MUTEX_RECURSIVE_NP)
-	      {
-		/* We do not need to ensure ordering wrt another memory
-		   access.  */
-		THREAD_SETMEM (THREAD_SELF, robust_head.list_op_pending, NULL);
-
-		/* Just bump the counter.  */
-		if (__glibc_unlikely (mutex->__data.__count + 1 == 0))
-		  /* Overflow of the counter.  */
-		  return EAGAIN;
-
-		++mutex->__data.__count;
-
-		return 0;
-	      }
-	  }
-
+	/* Try to acquire the lock first; in the uncontended case this CAS
+	   is the only access to the lock word.  Only if that fails do we
+	   need to look at the owner to handle recursive and error-checking
+	   mutexes, using the value the CAS returned.  */
 	int newval = id;
 # ifdef NO_INCR
 	newval |= FUTEX_WAITERS;
@@ -395,6 +369,36 @@ __pthread_mutex_lock_full (pthread_mutex_t *mutex)
 
 	if (oldval != 0)
 	  {
+	    /* Check whether we already hold the mutex.  */
+	    if (__glibc_unlikely ((oldval & FUTEX_TID_MASK) == id))
+	      {
+		if (kind == PTHREAD_MUTEX_ERRORCHECK_NP)
+		  {
+		    /* We do not need to ensure ordering wrt another memory
+		       access.  */
+		    THREAD_SETMEM (THREAD_SELF, robust_head.list_op_pending,
+				   NULL);
+		    return EDEADLK;
+		  }
+
+		if (kind == PTHREAD_MUTEX_RECURSIVE_NP)
+		  {
+		    /* We do not need to ensure ordering wrt another memory
+		       access.  */
+		    THREAD_SETMEM (THREAD_SELF, robust_head.list_op_pending,
+				   NULL);
+
+		    /* Just bump the counter.  */
+		    if (__glibc_unlikely (mutex->__data.__count + 1 == 0))
+		      /* Overflow of the counter.  */
+		      return EAGAIN;
+
+		    ++mutex->__data.__count;
+
+		    return 0;
+		  }
+	      }
+
 	    /* The mutex is locked.  The kernel will now take care of
 	       everything.  */
 	    int private = (robust
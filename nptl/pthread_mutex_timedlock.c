@@ -327,43 +327,47 @@ __pthread_mutex_clocklock_common (pthread_mutex_t *mutex,
 	    __asm ("" ::: "memory");
 	  }
 
-	oldval = mutex->__data.__lock;
+	/* Try to acquire the lock first; in the uncontended case this CAS
+	   is the only access to the lock word.  Only if that fails do we
+	   need to look at the owner to handle recursive and error-checking
+	   mutexes, using the value the CAS returned.  */
+	oldval = atomic_compare_and_exchange_val_acq (&mutex->__data.__lock,
+						      id, 0);
 
-	/* Check whether we already hold the mutex.  */
-	if (__glibc_unlikely ((oldval & FUTEX_TID_MASK) == id))
+	if (oldval != 0)
 	  {
-	    if (kind == PTHREAD_MUTEX_ERRORCHECK_NP)
+	    /* Check whether we already hold the mutex.  */
+	    if (__glibc_unlikely ((oldval & FUTEX_TID_MASK) == id))
 	      {
-		/* We do not need to ensure ordering wrt another memory
-		   access.  */
-		THREAD_SETMEM (THREAD_SELF, robust_head.list_op_pending, NULL);
-		return EDEADLK;
-	      }
+		if (kind == PTHREAD_MUTEX_ERRORCHECK_NP)
+		  {
+		    /* We do not need to ensure ordering wrt another memory
+		       access.  */
+		    THREAD_SETMEM (THREAD_SELF, robust_head.list_op_pending,
+				   NULL);
+		    return EDEADLK;
+		  }
 
-	    if (kind == PTHREAD_MUTEX_RECURSIVE_NP)
-	      {
-		/* We do not need to ensure ordering wrt another memory
-		   access.  */
-		THREAD_SETMEM (THREAD_SELF, robust_head.list_op_pending, NULL);
+		if (kind == PTHREAD_MUTEX_RECURSIVE_NP)
+		  {
+		    /* We do not need to ensure ordering wrt another memory
+		       access.  */
+		    THREAD_SETMEM (THREAD_SELF, robust_head.list_op_pending,
+				   NULL);
 
-		/* Just bump the counter.  */
-		if (__glibc_unlikely (mutex->__data.__count + 1 == 0))
-		  /* Overflow of the counter.  */
-		  return EAGAIN;
+		    /* Just bump the counter.  */
+		    if (__glibc_unlikely (mutex->__data.__count + 1 == 0))
+		      /* Overflow of the counter.  */
+		      return EAGAIN;
 
-		++mutex->__data.__count;
+		    ++mutex->__data.__count;
 
-		LIBC_PROBE (mutex_timedlock_acquired, 1, mutex);
+		    LIBC_PROBE (mutex_timedlock_acquired, 1, mutex);
 
-		return 0;
+		    return 0;
+		  }
 	      }
-	  }
-
-	oldval = atomic_compare_and_exchange_val_acq (&mutex->__data.__lock,
-						      id, 0);
 
-	if (oldval != 0)
-	  {
 	    /* The mutex is locked.  The kernel will now take care of
 	       everything.  The timeout value must be a relative value.
 	       Convert it.  */
@@ -95,8 +95,13 @@ __pthread_mutex_unlock_full (pthread_mutex_t *mutex, int decr)
 {
   int newowner = 0;
   int private;
+  /* See concurrency notes regarding __kind in struct __pthread_mutex_s
+     in sysdeps/nptl/bits/thread-shared-types.h.  The kind is loaded only
+     once here so that the PI paths below do not have to reload it.  */
+  int type = PTHREAD_MUTEX_TYPE (mutex);
+  int robust = type & PTHREAD_MUTEX_ROBUST_NORMAL_NP;
 
-  switch (PTHREAD_MUTEX_TYPE (mutex))
+  switch (type)
     {
     case PTHREAD_MUTEX_ROBUST_RECURSIVE_NP:
       /* Recursive mutex.  */
@@ -214,27 +219,22 @@ __pthread_mutex_unlock_full (pthread_mutex_t *mutex, int decr)
     case PTHREAD_MUTEX_PI_ROBUST_ERRORCHECK_NP:
     case PTHREAD_MUTEX_PI_ROBUST_NORMAL_NP:
     case PTHREAD_MUTEX_PI_ROBUST_ADAPTIVE_NP:
+      /* A TID is never zero, so this also checks that the mutex is
+	 locked.  */
       if ((mutex->__data.__lock & FUTEX_TID_MASK)
-	  != THREAD_GETMEM (THREAD_SELF, tid)
-	  || ! lll_islocked (mutex->__data.__lock))
+	  != THREAD_GETMEM (THREAD_SELF, tid))
 	return EPERM;
 
       /* If the previous owner died and the caller did not succeed in
 	 making the state consistent, mark the mutex as unrecoverable
 	 and make all waiters.  */
-      /* See concurrency notes regarding __kind in struct __pthread_mutex_s
-	 in sysdeps/nptl/bits/thread-shared-types.h.  */
-      if ((atomic_load_relaxed (&(mutex->__data.__kind))
-	   & PTHREAD_MUTEX_ROBUST_NORMAL_NP) != 0
+      if (robust
 	  && __builtin_expect (mutex->__data.__owner
 			       == PTHREAD_MUTEX_INCONSISTENT, 0))
       pi_notrecoverable:
        newowner = PTHREAD_MUTEX_NOTRECOVERABLE;
 
-      /* See concurrency notes regarding __kind in struct __pthread_mutex_s
-	 in sysdeps/nptl/bits/thread-shared-types.h.  */
-      if ((atomic_load_relaxed (&(mutex->__data.__kind))
-	   & PTHREAD_MUTEX_ROBUST_NORMAL_NP) != 0)
+      if (robust)
 	{
 	continue_pi_robust:
 	  /* Remove mutex from the list.
@@ -257,10 +257,6 @@ __pthread_mutex_unlock_full (pthread_mutex_t *mutex, int decr)
       /* Unlock.  Load all necessary mutex data before releasing the mutex
 	 to not violate the mutex destruction requirements (see
 	 lll_unlock).  */
-      /* See concurrency notes regarding __kind in struct __pthread_mutex_s
-	 in sysdeps/nptl/bits/thread-shared-types.h.  */
-      int robust = atomic_load_relaxed (&(mutex->__data.__kind))
-	& PTHREAD_MUTEX_ROBUST_NORMAL_NP;
       private = (robust
 		 ? PTHREAD_ROBUST_MUTEX_PSHARED (mutex)
 		 : PTHREAD_MUTEX_PSHARED (mutex));
@@ -284,8 +280,10 @@ __pthread_mutex_unlock_full (pthread_mutex_t *mutex, int decr)
 
       /* This happens after the kernel releases the mutex but violates the
 	 mutex destruction requirements; see comments in the code handling
-	 PTHREAD_MUTEX_ROBUST_NORMAL_NP.  */
-      THREAD_SETMEM (THREAD_SELF, robust_head.list_op_pending, NULL);
+	 PTHREAD_MUTEX_ROBUST_NORMAL_NP.  Non-robust mutexes never set
+	 op_pending, so there is nothing to clear for them.  */
+      if (robust)
+	THREAD_SETMEM (THREAD_SELF, robust_head.list_op_pending, NULL);
       break;
 #endif  /* __NR_futex.  */
 
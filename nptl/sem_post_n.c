@@ -0,0 +1,81 @@
+/* sem_post_n -- post several tokens to a POSIX semaphore at once.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <atomic.h>
+#include <errno.h>
+#include <sysdep.h>
+#include <futex-internal.h>
+#include <internaltypes.h>
+#include <semaphore.h>
+
+
+/* Like sem_post, but add N tokens with a single atomic operation and wake
+   up to N blocked waiters with a single futex_wake call.  See sem_wait for
+   an explanation of the algorithm.  */
+int
+__sem_post_n (sem_t *sem, unsigned int n)
+{
+  struct new_sem *isem = (struct new_sem *) sem;
+  int private = isem->private;
+
+  if (n == 0)
+    return 0;
+
+#if __HAVE_64B_ATOMICS
+  /* Add the tokens.  Release MO for the same reasons as in sem_post.  */
+  uint64_t d = atomic_load_relaxed (&isem->data);
+  do
+    {
+      if (n > SEM_VALUE_MAX - (d & SEM_VALUE_MASK))
+	{
+	  __set_errno (EOVERFLOW);
+	  return -1;
+	}
+    }
+  while (!atomic_compare_exchange_weak_release (&isem->data, &d, d + n));
+
+  /* We know how many waiters may be blocked, so do not wake more of them
+     than there are new tokens.  N is at most SEM_VALUE_MAX here, so it
+     fits into the futex_wake argument.  */
+  uint64_t nwaiters = d >> SEM_NWAITERS_SHIFT;
+  if (nwaiters > 0)
+    futex_wake (((unsigned int *) &isem->data) + SEM_VALUE_OFFSET,
+		nwaiters < n ? (int) nwaiters : (int) n, private);
+#else
+  /* Add the tokens.  Similar to 64b version.  */
+  unsigned int v = atomic_load_relaxed (&isem->value);
+  do
+    {
+      if (n > SEM_VALUE_MAX - (v >> SEM_VALUE_SHIFT))
+	{
+	  __set_errno (EOVERFLOW);
+	  return -1;
+	}
+    }
+  while (!atomic_compare_exchange_weak_release
+	 (&isem->value, &v, v + (n << SEM_VALUE_SHIFT)));
+
+  /* We only know whether there might be blocked waiters, not how many, so
+     wake as many as there are new tokens.  */
+  if ((v & SEM_NWAITERS_MASK) != 0)
+    futex_wake (&isem->value, (int) n, private);
+#endif
+
+  return 0;
+}
+weak_alias (__sem_post_n, sem_post_n)
@@ -167,6 +167,21 @@ __new_sem_wait_slow64 (struct new_sem *sem, clockid_t clockid,
 {
   int err = 0;
 
+  /* If requested through the glibc.pthread.sem_spin_count tunable, keep
+     polling for a token for a bounded number of iterations before we
+     register as a waiter.  In producer/consumer handoffs the next token
+     often arrives shortly, and not being registered also lets the
+     corresponding sem_post skip the futex_wake call.  The fast path only
+     reads the semaphore while there is no token, so this does not add
+     contention on the cache line.  */
+  int spin_count = max_sem_spin_count ();
+  for (int cnt = 0; cnt < spin_count; cnt++)
+    {
+      atomic_spin_nop ();
+      if (__new_sem_wait_fast (sem, 0) == 0)
+	return 0;
+    }
+
 #if __HAVE_64B_ATOMICS
   /* Add a waiter.  Relaxed MO is sufficient because we can rely on the
      ordering provided by the RMW operations we use.  */
@@ -0,0 +1,105 @@
+/* Test sem_post_n.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <errno.h>
+#include <limits.h>
+#include <semaphore.h>
+#include <support/check.h>
+#include <support/xthread.h>
+
+#define NTHREADS 8
+#define ROUNDS 1000
+
+static sem_t items;
+static sem_t done;
+
+/* Consume ROUNDS tokens from ITEMS, acknowledging each one on DONE.  */
+static void *
+consumer (void *arg)
+{
+  for (int i = 0; i < ROUNDS; i++)
+    {
+      TEST_COMPARE (sem_wait (&items), 0);
+      TEST_COMPARE (sem_post (&done), 0);
+    }
+  return NULL;
+}
+
+static int
+do_test (void)
+{
+  sem_t s;
+  int val;
+
+  /* Posting zero tokens does nothing.  */
+  TEST_COMPARE (sem_init (&s, 0, 0), 0);
+  TEST_COMPARE (sem_post_n (&s, 0), 0);
+  TEST_COMPARE (sem_getvalue (&s, &val), 0);
+  TEST_COMPARE (val, 0);
+
+  TEST_COMPARE (sem_post_n (&s, 5), 0);
+  TEST_COMPARE (sem_getvalue (&s, &val), 0);
+  TEST_COMPARE (val, 5);
+  for (int i = 0; i < 5; i++)
+    TEST_COMPARE (sem_trywait (&s), 0);
+  TEST_COMPARE (sem_trywait (&s), -1);
+  TEST_COMPARE (errno, EAGAIN);
+
+  /* Overflow is detected before any token is added.  */
+  TEST_COMPARE (sem_post_n (&s, SEM_VALUE_MAX), 0);
+  TEST_COMPARE (sem_post_n (&s, 1), -1);
+  TEST_COMPARE (errno, EOVERFLOW);
+  TEST_COMPARE (sem_getvalue (&s, &val), 0);
+  TEST_COMPARE (val, SEM_VALUE_MAX);
+  TEST_COMPARE (sem_destroy (&s), 0);
+
+  TEST_COMPARE (sem_init (&s, 0, 1), 0);
+  TEST_COMPARE (sem_post_n (&s, SEM_VALUE_MAX), -1);
+  TEST_COMPARE (errno, EOVERFLOW);
+  TEST_COMPARE (sem_getvalue (&s, &val), 0);
+  TEST_COMPARE (val, 1);
+  TEST_COMPARE (sem_destroy (&s), 0);
+
+  /* Hand batches of tokens to a set of (possibly blocked) consumers and
+     make sure that every token is consumed exactly once.  */
+  TEST_COMPARE (sem_init (&items, 0, 0), 0);
+  TEST_COMPARE (sem_init (&done, 0, 0), 0);
+
+  pthread_t thr[NTHREADS];
+  for (int i = 0; i < NTHREADS; i++)
+    thr[i] = xpthread_create (NULL, consumer, NULL);
+
+  for (int i = 0; i < ROUNDS; i++)
+    {
+      TEST_COMPARE (sem_post_n (&items, NTHREADS), 0);
+      for (int j = 0; j < NTHREADS; j++)
+	TEST_COMPARE (sem_wait (&done), 0);
+    }
+
+  for (int i = 0; i < NTHREADS; i++)
+    xpthread_join (thr[i]);
+
+  TEST_COMPARE (sem_getvalue (&items, &val), 0);
+  TEST_COMPARE (val, 0);
+  TEST_COMPARE (sem_destroy (&items), 0);
+  TEST_COMPARE (sem_destroy (&done), 0);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -75,7 +75,12 @@ $2 == "g" || $2 == "w" && (NF == 7 || NF == 8) {
     seen_opd = -1;
   }
   else if ($4 == "*ABS*") {
-    next;
+    # Version definitions show up as absolute symbols named after the
+    # version.  Only list the GLIBC_ABI_* markers, which have no other
+    # symbols.
+    if (symbol != version || version !~ /^GLIBC_ABI_/)
+      next;
+    desc = symbol " A";
   }
   else if (type == "D") {
     # Accept unchanged.
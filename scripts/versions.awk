@@ -132,9 +132,16 @@ END {
 	closeversion(oldver, veryoldver);
 	veryoldver = oldver;
       }
-      printf("%s {\n  global:\n", $2) > outfile;
+      # Versions without symbols only list a placeholder, which is not
+      # printed.  An empty global: list would be a syntax error.
+      if ($3 == "__placeholder_only_for_empty_version_map;")
+	printf("%s {\n", $2) > outfile;
+      else
+	printf("%s {\n  global:\n", $2) > outfile;
       oldver = $2;
     }
+    if ($3 == "__placeholder_only_for_empty_version_map;")
+      continue;
     printf("   ") > outfile;
     for (n = 3; n <= NF; ++n) {
       printf(" %s", $n) > outfile;
@@ -292,6 +292,45 @@ STRCOLL (const STRING_TYPE *s1, const STRING_TYPE *s2, locale_t l)
 
   int result = 0, rule = 0;
 
+#ifndef WIDE_CHAR_VERSION
+  /* Skip the common prefix of bytes which are collating elements on
+     their own, such as the ASCII letters in most locales.  The prefix
+     must end with an element whose rule sorts all levels forward, so
+     that no backward sequence continues past it.  Then it adds the
+     same weights at every level to both strings, and the comparison
+     only depends on the rest.  */
+  size_t prefix = 0;
+  int prefix_rule = 0;
+  {
+    int last_rule = -1, last_forward = 0;
+    for (size_t cnt = 0; s1[cnt] == s2[cnt] && s1[cnt] != '\0'; ++cnt)
+      {
+	int32_t tmp = table[(USTRING_TYPE) s1[cnt]];
+	if (tmp < 0)
+	  break;
+	if ((tmp >> 24) != last_rule)
+	  {
+	    last_rule = tmp >> 24;
+	    last_forward = 1;
+	    for (int pass = 0; pass < nrules; ++pass)
+	      if ((rulesets[last_rule * nrules + pass] & sort_backward) != 0)
+		last_forward = 0;
+	  }
+	if (last_forward)
+	  prefix = cnt + 1;
+      }
+    if (prefix > 0)
+      {
+	if (s1[prefix] == '\0' && s2[prefix] == '\0')
+	  /* The strings are equal.  */
+	  return 0;
+	prefix_rule = table[(USTRING_TYPE) s1[0]] >> 24;
+	s1 += prefix;
+	s2 += prefix;
+      }
+  }
+#endif
+
   /* With GCC 7 when compiling with -Os the compiler warns that
      seq1.back_us and seq2.back_us might be used uninitialized.
      Sometimes this warning appears at locations in locale/weightwc.h
@@ -362,7 +401,12 @@ STRCOLL (const STRING_TYPE *s1, const STRING_TYPE *s2, locale_t l)
 	    return result;
 	}
 
+#ifndef WIDE_CHAR_VERSION
+      /* The rule of the first sequence, which may have been skipped.  */
+      rule = prefix > 0 ? prefix_rule : seq1.rule;
+#else
       rule = seq1.rule;
+#endif
     }
 
   return result;
@@ -0,0 +1,82 @@
+/* Test strcoll on strings with a common prefix.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <locale.h>
+#include <stdio.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/support.h>
+
+/* strcoll skips the common prefix of single-byte collating elements.
+   The order must still depend on contractions, accents and case after
+   the prefix, and on the prefix where its elements sort a level
+   backward.  */
+
+static const struct
+{
+  const char *locale;
+  const char *s1;
+  const char *s2;
+  int expected;
+} tests[] =
+  {
+    { "en_US.UTF-8", "Johnson, Robert", "Johnson, Robert", 0 },
+    { "en_US.UTF-8", "Johnson, Robert a", "Johnson, Robert B", -1 },
+    { "en_US.UTF-8", "Johnson, Robert", "Johnson, Roberta", -1 },
+    { "en_US.UTF-8", "record a", "record A", -1 },
+    { "en_US.UTF-8", "resume", "r\xc3\xa9sum\xc3\xa9", -1 },
+    { "en_US.UTF-8", "r\xc3\xa9sum\xc3\xa9", "resumes", -1 },
+    { "en_US.UTF-8", "file-name", "file name", 1 },
+    { "de_DE.UTF-8", "Stra\xc3\x9f" "e", "Strasse", 1 },
+    { "de_DE.UTF-8", "Schl\xc3\xbcssel", "Schlz", -1 },
+    { "cs_CZ.UTF-8", "prefixconfig", "prefixchoose", -1 },
+    { "cs_CZ.UTF-8", "abcch", "abcd", 1 },
+    { "cs_CZ.UTF-8", "abchx", "abcix", 1 },
+    { "da_DK.ISO-8859-1", "xAS", "xAA", -1 },
+    { "da_DK.ISO-8859-1", "mAAx", "mAAx", 0 },
+    { "fr_CA.UTF-8", "cote", "cot\xc3\xa9", -1 },
+    { "fr_CA.UTF-8", "cot\xc3\xa9", "c\xc3\xb4te", 1 },
+  };
+
+static int
+sign (int x)
+{
+  return (x > 0) - (x < 0);
+}
+
+static int
+do_test (void)
+{
+  for (size_t i = 0; i < sizeof (tests) / sizeof (tests[0]); ++i)
+    {
+      xsetlocale (LC_ALL, tests[i].locale);
+      int r1 = sign (strcoll (tests[i].s1, tests[i].s2));
+      int r2 = sign (strcoll (tests[i].s2, tests[i].s1));
+      if (r1 != tests[i].expected || r2 != -tests[i].expected)
+	{
+	  printf ("error: %s: strcoll (\"%s\", \"%s\") = %d, reversed %d,"
+		  " expected %d\n", tests[i].locale, tests[i].s1,
+		  tests[i].s2, r1, r2, tests[i].expected);
+	  support_record_failure ();
+	}
+    }
+
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -220,6 +220,13 @@ enum cache_extension_tag
       size must be a multiple of 4.  */
    cache_extension_tag_glibc_hwcaps,
 
+   /* Hash table over the keys of the file entries, a struct
+      cache_soname_index.  It lets the dynamic loader find the first
+      entry for a name without a binary search over the string table.
+
+      For this section, 4-byte alignment is required.  */
+   cache_extension_tag_soname_index,
+
    /* Total number of known cache extension tags.  */
    cache_extension_count
   };
@@ -274,6 +281,52 @@ struct cache_extension_all_loaded
   struct cache_extension_loaded sections[cache_extension_count];
 };
 
+/* Slot in the cache_extension_tag_soname_index hash table.  */
+struct cache_soname_index_slot
+{
+  /* Value of _dl_cache_soname_hash for the key of the entry.  */
+  uint32_t hash;
+
+  /* One plus the index of the first file entry with this key, so that
+     zero marks an empty slot.  */
+  uint32_t entry;
+};
+
+/* Contents of the cache_extension_tag_soname_index section.  The
+   table uses open addressing with linear probing.  ldconfig keeps it
+   at most half full, so most lookups only look at a single slot.  */
+struct cache_soname_index
+{
+  /* Number of slots, a power of two.  */
+  uint32_t nslots;
+  uint32_t unused;
+  struct cache_soname_index_slot slots[];
+};
+
+/* Hash function for struct cache_soname_index.  _dl_cache_libcmp
+   compares sequences of digits numerically, so leading zeros in such
+   a sequence are not hashed.  */
+static inline uint32_t
+_dl_cache_soname_hash (const char *name)
+{
+  uint32_t hash = 5381;
+  bool in_number = false;
+  for (; *name != '\0'; ++name)
+    {
+      unsigned char c = *name;
+      if (c >= '0' && c <= '9')
+	{
+	  if (!in_number && c == '0' && name[1] >= '0' && name[1] <= '9')
+	    continue;
+	  in_number = true;
+	}
+      else
+	in_number = false;
+      hash = hash * 33 + c;
+    }
+  return hash;
+}
+
 /* Performs basic data validation based on section tag, and removes
    the sections which are invalid.  */
 static void
@@ -293,6 +346,27 @@ cache_extension_verify (struct cache_extension_all_loaded *loaded)
 	hwcaps->flags = 0;
       }
   }
+
+  {
+    /* The number of slots must be a non-zero power of two, and the
+       slots must fill the section exactly.  */
+    struct cache_extension_loaded *index
+      = &loaded->sections[cache_extension_tag_soname_index];
+    const struct cache_soname_index *table = index->base;
+    if (index->size < sizeof (struct cache_soname_index)
+	|| ((uintptr_t) index->base % 4) != 0
+	|| table->nslots == 0
+	|| (table->nslots & (table->nslots - 1)) != 0
+	|| ((index->size - sizeof (struct cache_soname_index))
+	    / sizeof (struct cache_soname_index_slot)) != table->nslots
+	|| ((index->size - sizeof (struct cache_soname_index))
+	    % sizeof (struct cache_soname_index_slot)) != 0)
+      {
+	index->base = NULL;
+	index->size = 0;
+	index->flags = 0;
+      }
+  }
 }
 
 static bool __attribute__ ((unused))
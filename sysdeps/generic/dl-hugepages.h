@@ -0,0 +1,41 @@
+/* Huge page support for the mappings of ld.so.  Generic version.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _DL_HUGEPAGES_H
+#define _DL_HUGEPAGES_H
+
+#include <link.h>
+#include <stddef.h>
+
+/* Return the huge page size to which executable segments are aligned
+   if the glibc.rtld.hugepages tunable is enabled, or 0 if they are
+   mapped as usual.  */
+static inline size_t
+_dl_hugepage_size (void)
+{
+  return 0;
+}
+
+/* Ask for the huge pages of size SIZE which lie within [START, END) to
+   be used for that range.  */
+static inline void
+_dl_hugepage_advise (ElfW(Addr) start, ElfW(Addr) end, size_t size)
+{
+}
+
+#endif /* _DL_HUGEPAGES_H */
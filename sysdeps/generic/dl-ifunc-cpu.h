@@ -0,0 +1,35 @@
+/* CPU state which selects IFUNC implementations.  Generic version.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _DL_IFUNC_CPU_H
+#define _DL_IFUNC_CPU_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Set *DATA and *SIZE to the data on which the IFUNC resolvers of the
+   system base their choice, and return true.  The IFUNC cache (see
+   dl-ifunc-cache.c) records resolver results for this data only.
+   Return false if the data is not known, which disables the cache.  */
+static inline bool
+_dl_ifunc_cpu_data (const void **data, size_t *size)
+{
+  return false;
+}
+
+#endif /* _DL_IFUNC_CPU_H */
@@ -243,6 +243,14 @@ enum allowmask
     allow_ldso = 8
   };
 
+/* Type of the algorithm used by _dl_sort_maps, selected by the
+   glibc.rtld.dynamic_sort tunable.  */
+enum dso_sort_algorithm
+  {
+    dso_sort_algorithm_original,
+    dso_sort_algorithm_dfs
+  };
+
 
 struct audit_ifaces
 {
@@ -401,6 +409,10 @@ struct rtld_global
   /* Used to store the audit information for the link map of the
      dynamic loader.  */
   struct auditstate _dl_rtld_auditstate[DL_NNS];
+
+  /* File to which the startup profile is written (from
+     LD_STARTUP_PROFILE_OUTPUT), or NULL if no profile is recorded.  */
+  EXTERN const char *_dl_startup_profile_output;
 #endif
 
 #if defined SHARED && defined _LIBC_REENTRANT \
@@ -568,6 +580,9 @@ struct rtld_global_ro
      linking.  */
   EXTERN int _dl_dynamic_weak;
 
+  /* Algorithm used by _dl_sort_maps.  */
+  EXTERN enum dso_sort_algorithm _dl_dso_sort_algo;
+
   /* Default floating-point control word.  */
   EXTERN fpu_control_t _dl_fpu_control;
 
@@ -978,6 +993,23 @@ extern lookup_t _dl_lookup_symbol_x (const char *undef,
 				     struct link_map *skip_map)
      attribute_hidden;
 
+/* Enable caching of the results of _dl_lookup_symbol_x in the global
+   scope of MAIN_MAP.  Only valid while the global scope does not change,
+   i.e. during the initial relocation of the objects loaded at startup.  */
+extern void _dl_lookup_cache_init (struct link_map *main_map)
+     attribute_hidden;
+
+/* Disable and free the cache set up by _dl_lookup_cache_init.  */
+extern void _dl_lookup_cache_fini (void) attribute_hidden;
+
+/* If glibc.rtld.scope_summary is set, compute the summary of the
+   symbols defined in the global scope of MAIN_MAP, which allows lookups
+   to skip objects that do not define the symbol.  The objects loaded at
+   startup are never removed from the global scope, so the summary
+   remains valid for them.  */
+extern void _dl_scope_summary_init (struct link_map *main_map)
+     attribute_hidden;
+
 
 /* Restricted version of _dl_lookup_symbol_x.  Searches MAP (and only
    MAP) for the symbol UNDEF_NAME, with GNU hash NEW_HASH (computed
@@ -1010,6 +1042,13 @@ extern void _dl_relocate_object (struct link_map *map,
 				 int reloc_mode, int consider_profiling)
      attribute_hidden;
 
+/* Apply the DT_RELR relocations of the objects in the search list of
+   MAIN_MAP ahead of _dl_relocate_object, using up to NTHREADS threads.
+   Objects handled here are marked with l_relr_done.  */
+extern void _dl_relocate_relr_parallel (struct link_map *main_map,
+					unsigned int nthreads)
+     attribute_hidden;
+
 /* Protect PT_GNU_RELRO area.  */
 extern void _dl_protect_relro (struct link_map *map) attribute_hidden;
 
@@ -1049,6 +1088,9 @@ extern void _dl_fini (void) attribute_hidden;
 extern void _dl_sort_maps (struct link_map **maps, unsigned int nmaps,
 			   char *used, bool for_fini) attribute_hidden;
 
+/* Select the algorithm used by _dl_sort_maps.  */
+extern void _dl_sort_maps_init (void) attribute_hidden;
+
 /* The dynamic linker calls this function before and having changing
    any shared object mappings.  The `r_state' member of `struct r_debug'
    says what change is taking place.  This function's address is
@@ -1241,6 +1283,18 @@ extern void _dl_show_scope (struct link_map *new, int from)
 extern struct link_map *_dl_find_dso_for_object (const ElfW(Addr) addr);
 rtld_hidden_proto (_dl_find_dso_for_object)
 
+/* Rebuild the sorted address ranges used by _dl_find_object and
+   _dl_find_dso_for_object from the namespace lists, leaving out
+   objects marked with l_removed.  Must be called with GL(dl_load_lock)
+   held.  Return false if memory allocation fails, in which case the
+   previous data is still in use.  */
+extern bool _dl_find_object_update (void) attribute_hidden;
+
+#ifndef SHARED
+/* Set up the data used by _dl_find_object in a static executable.  */
+extern void _dl_find_object_init (void) attribute_hidden;
+#endif
+
 /* Initialization which is normally done by the dynamic linker.  */
 extern void _dl_non_dynamic_init (void)
      attribute_hidden;
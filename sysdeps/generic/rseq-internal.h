@@ -0,0 +1,40 @@
+/* Restartable Sequences internal API.  Stub version.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef RSEQ_INTERNAL_H
+#define RSEQ_INTERNAL_H
+
+#include <stdbool.h>
+
+struct pthread;
+
+/* Register the rseq area of SELF with the kernel if DO_RSEQ.  Returns
+   true on success.  */
+static inline bool
+rseq_register_current_thread (struct pthread *self, bool do_rseq)
+{
+  return false;
+}
+
+/* Register the rseq area of the initial thread, if enabled.  */
+static inline void
+rseq_register_main_thread (void)
+{
+}
+
+#endif /* rseq-internal.h */
@@ -77,6 +77,12 @@ extern int sem_trywait (sem_t *__sem) __THROWNL __nonnull ((1));
 /* Post SEM.  */
 extern int sem_post (sem_t *__sem) __THROWNL __nonnull ((1));
 
+#ifdef __USE_GNU
+/* Post N tokens to SEM at once, waking up to N waiters.  */
+extern int sem_post_n (sem_t *__sem, unsigned int __n)
+  __THROWNL __nonnull ((1));
+#endif
+
 /* Get current value of SEM and store it in *SVAL.  */
 extern int sem_getvalue (sem_t *__restrict __sem, int *__restrict __sval)
   __THROW __nonnull ((1, 2));
@@ -0,0 +1,32 @@
+/* The internal wrapper of clone and clone3.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _CLONE_INTERNAL_H
+#define _CLONE_INTERNAL_H
+
+#include <clone3.h>
+
+/* The clone3 wrapper to create a thread or process with all of its
+   parameters (stack, TLS, TID locations) passed in CL_ARGS in a single
+   system call.  If __clone3 is not available or the kernel returns
+   ENOSYS, fall back to clone with the equivalent arguments.  */
+extern int __clone_internal (struct clone_args *__cl_args,
+			     int (*__func) (void *__arg), void *__arg);
+libc_hidden_proto (__clone_internal)
+
+#endif
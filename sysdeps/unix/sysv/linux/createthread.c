@@ -27,12 +27,8 @@
 #include <stdint.h>
 
 #include <arch-fork.h>
-
-#ifdef __NR_clone2
-# define ARCH_CLONE __clone2
-#else
-# define ARCH_CLONE __clone
-#endif
+#include <clone_internal.h>
+#include <stackinfo.h>
 
 /* See the comments in pthread_create.c for the requirements for these
    two macros and the create_thread function.  */
@@ -100,9 +96,32 @@ create_thread (struct pthread *pd, const struct pthread_attr *attr,
 
   TLS_DEFINE_INIT_TP (tp, pd);
 
-  if (__glibc_unlikely (ARCH_CLONE (&start_thread, STACK_VARIABLES_ARGS,
-				    clone_flags, pd, &pd->tid, tp, &pd->tid)
-			== -1))
+  /* clone3 wants the lowest address of the stack and its size, while
+     ALLOCATE_STACK hands back the initial stack pointer.  */
+#ifdef NEED_SEPARATE_REGISTER_STACK
+  void *stack = stackaddr;
+  size_t stack_size = stacksize;
+#elif _STACK_GROWS_DOWN
+  void *stack = pd->stackblock;
+  size_t stack_size = (char *) stackaddr - (char *) pd->stackblock;
+#else
+  void *stack = stackaddr;
+  size_t stack_size = pd->stackblock_size;
+#endif
+
+  /* Pass the stack, the thread pointer and both TID locations in one
+     go so that the kernel can set up the new thread with a single
+     clone3 call.  */
+  struct clone_args args =
+    {
+      .flags = clone_flags,
+      .parent_tid = (uintptr_t) &pd->tid,
+      .child_tid = (uintptr_t) &pd->tid,
+      .stack = (uintptr_t) stack,
+      .stack_size = stack_size,
+      .tls = (uintptr_t) tp,
+    };
+  if (__glibc_unlikely (__clone_internal (&args, &start_thread, pd) == -1))
     return errno;
 
   /* It's started now, so if we fail below, we'll have to cancel it
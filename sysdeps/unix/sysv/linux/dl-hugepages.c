@@ -0,0 +1,64 @@
+/* Huge page size lookup for the mappings of ld.so.  Linux version.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <dl-hugepages.h>
+#include <dl-tunables.h>
+#include <fcntl.h>
+#include <not-cancel.h>
+#include <sys/param.h>
+
+/* Return the transparent huge page size of the system, or 0 if it is
+   not known.  */
+static size_t
+hugepage_size_read (void)
+{
+  int fd = __open64_nocancel ("/sys/kernel/mm/transparent_hugepage/"
+			      "hpage_pmd_size", O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return 0;
+  char buf[32];
+  ssize_t n = __read_nocancel (fd, buf, sizeof (buf));
+  __close_nocancel (fd);
+
+  size_t size = 0;
+  for (ssize_t i = 0; i < n && buf[i] >= '0' && buf[i] <= '9'; ++i)
+    size = size * 10 + buf[i] - '0';
+  /* Only a power of two larger than the page size is of use.  */
+  if (size <= GLRO(dl_pagesize) || !powerof2 (size))
+    return 0;
+  return size;
+}
+
+size_t
+_dl_hugepage_size (void)
+{
+#if HAVE_TUNABLES
+  /* The size is read once, when the first object is mapped.  */
+  static size_t size = -1;
+  if (size == (size_t) -1)
+    {
+      if (TUNABLE_GET_FULL (glibc, rtld, hugepages, int32_t, NULL) != 0)
+	size = hugepage_size_read ();
+      else
+	size = 0;
+    }
+  return size;
+#else
+  return 0;
+#endif
+}
@@ -0,0 +1,46 @@
+/* Huge page support for the mappings of ld.so.  Linux version.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _DL_HUGEPAGES_H
+#define _DL_HUGEPAGES_H
+
+#include <ldsodefs.h>
+#include <libc-pointer-arith.h>
+#include <sys/mman.h>
+
+/* Executable segments are backed by transparent huge pages.  For file
+   mappings, this needs a kernel with CONFIG_READ_ONLY_THP_FOR_FS, and
+   the pages are collapsed by khugepaged after the MADV_HUGEPAGE advice
+   only.  */
+
+/* Return the huge page size to which executable segments are aligned
+   if the glibc.rtld.hugepages tunable is enabled, or 0 if they are
+   mapped as usual.  */
+extern size_t _dl_hugepage_size (void) attribute_hidden;
+
+static inline void
+_dl_hugepage_advise (ElfW(Addr) start, ElfW(Addr) end, size_t size)
+{
+  start = ALIGN_UP (start, size);
+  end = ALIGN_DOWN (end, size);
+  /* Failure only means that the range stays on base pages.  */
+  if (end > start)
+    __madvise ((void *) start, end - start, MADV_HUGEPAGE);
+}
+
+#endif /* _DL_HUGEPAGES_H */
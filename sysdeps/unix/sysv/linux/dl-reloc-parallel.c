@@ -0,0 +1,141 @@
+/* Parallel relative relocation of the initial objects.  Linux version.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <atomic.h>
+#include <ldsodefs.h>
+#include <libc-pointer-arith.h>
+#include <lowlevellock-futex.h>
+#include <sched.h>
+#include <stackinfo.h>
+#include <sys/mman.h>
+#include <dynamic-link.h>
+
+/* Symbol lookups, IFUNC resolvers, copy relocations, static TLS
+   allocation and the minimal malloc of ld.so all rely on running on a
+   single thread, so only the DT_RELR relocations are applied here.
+   They depend on nothing but the load address of the object they
+   belong to and usually make up the bulk of the relocation work.
+   Objects with text relocations are left alone because their segments
+   are made writable only by _dl_relocate_object.
+
+   The workers are bare clone threads without a TCB of their own.  They
+   must not touch thread-local data, which is why nothing but the
+   relocation loop runs on them.  */
+
+/* The workers need very little stack.  */
+#define WORKER_STACK_SIZE (16 * 1024)
+
+/* Work shared between the threads.  */
+static struct link_map **relr_list;
+static unsigned int relr_count;
+static unsigned int relr_next;
+
+static bool
+relr_parallel_p (struct link_map *l)
+{
+  return (l != &GL(dl_rtld_map)
+	  && l->l_info[DT_RELR] != NULL
+	  && l->l_addr != 0
+	  && l->l_info[DT_TEXTREL] == NULL
+	  && !l->l_relr_done);
+}
+
+static int
+relr_worker (void *arg)
+{
+  while (true)
+    {
+      unsigned int i = atomic_fetch_add_relaxed (&relr_next, 1);
+      if (i >= relr_count)
+	break;
+      struct link_map *l = relr_list[i];
+      if (relr_parallel_p (l))
+	ELF_DYNAMIC_DO_RELR (l);
+    }
+  return 0;
+}
+
+void
+_dl_relocate_relr_parallel (struct link_map *main_map, unsigned int nthreads)
+{
+  struct link_map **list = main_map->l_searchlist.r_list;
+  unsigned int nlist = main_map->l_searchlist.r_nlist;
+
+  unsigned int nrelr = 0;
+  for (unsigned int i = 0; i < nlist; i++)
+    nrelr += relr_parallel_p (list[i]);
+
+  /* With a single candidate there is nothing to run in parallel.  */
+  if (nthreads < 2 || nrelr < 2)
+    return;
+  if (nthreads > nrelr)
+    nthreads = nrelr;
+
+  relr_list = list;
+  relr_count = nlist;
+  relr_next = 0;
+
+  /* The calling thread is the first worker.  */
+  unsigned int nworkers = nthreads - 1;
+  size_t stacksize = ALIGN_UP (WORKER_STACK_SIZE, GLRO(dl_pagesize));
+  char *stacks = __mmap (NULL, nworkers * stacksize, PROT_READ | PROT_WRITE,
+			 MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+  if (stacks == MAP_FAILED)
+    nworkers = 0;
+
+  /* The kernel clears the TID of a worker and wakes up the futex on it
+     once the worker has exited and no longer uses its stack.  */
+  pid_t tids[nworkers > 0 ? nworkers : 1];
+  const int clone_flags = (CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_SYSVSEM
+			   | CLONE_SIGHAND | CLONE_THREAD
+			   | CLONE_PARENT_SETTID | CLONE_CHILD_CLEARTID);
+  unsigned int started = 0;
+  for (; started < nworkers; started++)
+    {
+      char *stack = stacks + started * stacksize;
+#if _STACK_GROWS_DOWN
+      stack += stacksize;
+#endif
+      tids[started] = 0;
+      if (__clone (relr_worker, stack, clone_flags, NULL, &tids[started],
+		   NULL, &tids[started]) == -1)
+	/* Whatever the started workers do not pick up is handled by
+	   this thread.  */
+	break;
+    }
+
+  relr_worker (NULL);
+
+  for (unsigned int i = 0; i < started; i++)
+    {
+      pid_t tid;
+      while ((tid = atomic_load_acquire (&tids[i])) != 0)
+	lll_futex_wait (&tids[i], tid, LLL_SHARED);
+    }
+
+  if (stacks != MAP_FAILED)
+    __munmap (stacks, nworkers * stacksize);
+
+  for (unsigned int i = 0; i < nlist; i++)
+    if (relr_parallel_p (list[i]))
+      list[i]->l_relr_done = 1;
+
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_RELOC))
+    _dl_debug_printf ("\napplied DT_RELR relocations of %u objects"
+		      " using %u threads\n", nrelr, started + 1);
+}
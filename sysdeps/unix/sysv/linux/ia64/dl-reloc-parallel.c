@@ -0,0 +1,3 @@
+/* There is no __clone on ia64, only __clone2, which needs a separate
+   register stack.  Keep applying all relocations serially.  */
+#include <elf/dl-reloc-parallel.c>
@@ -0,0 +1,77 @@
+/* Restartable Sequences internal API.  Linux implementation.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef RSEQ_INTERNAL_H
+#define RSEQ_INTERNAL_H
+
+#include <sysdep.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/rseq.h>
+#include <tls.h>
+#if HAVE_TUNABLES
+# include <elf/dl-tunables.h>
+#endif
+
+/* Writable view of __rseq_size, which <sys/rseq.h> declares const.  It
+   is defined in rseq-symbols.c and cleared if the initial thread could
+   not register its rseq area.  */
+extern unsigned int __rseq_size_rw __asm__ ("__rseq_size");
+
+/* Register the rseq area of SELF, which must be the calling thread,
+   with the kernel if DO_RSEQ.  Returns true on success.  On failure,
+   or if !DO_RSEQ, the cpu_id field is set to
+   RSEQ_CPU_ID_REGISTRATION_FAILED so that readers such as sched_getcpu
+   fall back to asking the kernel.  */
+static inline bool
+rseq_register_current_thread (struct pthread *self, bool do_rseq)
+{
+  self->rseq_area.cpu_id = RSEQ_CPU_ID_REGISTRATION_FAILED;
+#if defined RSEQ_SIG && defined __NR_rseq
+  if (do_rseq)
+    {
+      /* The area may come from a cached stack of a thread which exited
+	 inside a critical section.  The kernel requires rseq_cs and
+	 flags to be clear at registration time.  */
+      memset (&self->rseq_area.rseq_cs, 0, sizeof (self->rseq_area.rseq_cs));
+      self->rseq_area.flags = 0;
+      int ret = INTERNAL_SYSCALL_CALL (rseq, &self->rseq_area,
+				       sizeof (self->rseq_area), 0, RSEQ_SIG);
+      if (!INTERNAL_SYSCALL_ERROR_P (ret))
+	return true;
+      self->rseq_area.cpu_id = RSEQ_CPU_ID_REGISTRATION_FAILED;
+    }
+#endif
+  return false;
+}
+
+/* Register the rseq area of the initial thread unless disabled by the
+   glibc.pthread.rseq tunable.  __rseq_size is set to 0 if this fails,
+   and then threads created later do not try to register either.  */
+static inline void
+rseq_register_main_thread (void)
+{
+  bool do_rseq = true;
+#if HAVE_TUNABLES
+  do_rseq = TUNABLE_GET_FULL (glibc, pthread, rseq, int32_t, NULL) != 0;
+#endif
+  if (!rseq_register_current_thread (THREAD_SELF, do_rseq))
+    __rseq_size_rw = 0;
+}
+
+#endif /* rseq-internal.h */
@@ -0,0 +1,43 @@
+/* Restartable Sequences exported symbols.  Linux version.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stddef.h>
+#include <rseq-internal.h>
+
+/* The rseq area lives in struct pthread, at a fixed offset from the
+   thread pointer.  Only architectures which define RSEQ_SIG register
+   the area, so the offset only needs to be right for those.  */
+#if TLS_TCB_AT_TP
+const ptrdiff_t __rseq_offset = offsetof (struct pthread, rseq_area);
+#elif TLS_DTV_AT_TP
+const ptrdiff_t __rseq_offset = (offsetof (struct pthread, rseq_area)
+				 - TLS_PRE_TCB_SIZE);
+#else
+# error "Either TLS_TCB_AT_TP or TLS_DTV_AT_TP must be defined"
+#endif
+
+/* Cleared by rseq_register_main_thread if registration fails or is
+   disabled.  */
+#ifdef RSEQ_SIG
+unsigned int __rseq_size_rw __asm__ ("__rseq_size")
+  = sizeof (struct rseq);
+#else
+unsigned int __rseq_size_rw __asm__ ("__rseq_size");
+#endif
+
+const unsigned int __rseq_flags;
@@ -0,0 +1,102 @@
+/* Restartable Sequences registration and sched_getcpu tests.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <errno.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <sys/rseq.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <support/check.h>
+#include <support/xthread.h>
+#include <tls.h>
+
+/* Locate the rseq area of the calling thread the way an application
+   would, starting from the thread pointer.  */
+static struct rseq *
+rseq_area (void)
+{
+#if TLS_TCB_AT_TP
+  char *tp = (char *) THREAD_SELF;
+#else
+  char *tp = (char *) THREAD_SELF + TLS_PRE_TCB_SIZE;
+#endif
+  struct rseq *area = (struct rseq *) (tp + __rseq_offset);
+  TEST_VERIFY (area == &THREAD_SELF->rseq_area);
+  return area;
+}
+
+/* Check that the rseq area of the calling thread is registered and
+   that sched_getcpu agrees with it.  The thread may migrate between
+   the reads, so retry a few times before declaring a mismatch.  */
+static void
+check_rseq_registered (void)
+{
+  struct rseq *area = rseq_area ();
+  bool matched = false;
+  for (int i = 0; i < 100 && !matched; ++i)
+    {
+      int cpu = (int) __atomic_load_n (&area->cpu_id, __ATOMIC_RELAXED);
+      TEST_VERIFY_EXIT (cpu >= 0);
+      unsigned int kernel_cpu;
+      TEST_COMPARE (syscall (__NR_getcpu, &kernel_cpu, NULL, NULL), 0);
+      matched = cpu == sched_getcpu () && cpu == (int) kernel_cpu;
+    }
+  TEST_VERIFY (matched);
+
+#ifdef __NR_rseq
+  /* A second registration of the same area must be rejected because
+     glibc already registered it.  */
+  TEST_COMPARE (syscall (__NR_rseq, area, __rseq_size, 0, RSEQ_SIG), -1);
+  TEST_COMPARE (errno, EBUSY);
+#endif
+}
+
+static void *
+threadfunc (void *closure)
+{
+  check_rseq_registered ();
+  return NULL;
+}
+
+static int
+do_test (void)
+{
+  TEST_COMPARE (__rseq_flags, 0);
+
+#ifdef RSEQ_SIG
+  if (__rseq_size == 0)
+    {
+      /* Registration can fail if the kernel lacks rseq support.  */
+      TEST_VERIFY (sched_getcpu () >= 0 || errno == ENOSYS);
+      FAIL_UNSUPPORTED ("rseq area not registered");
+    }
+  TEST_VERIFY (__rseq_size >= sizeof (struct rseq));
+
+  check_rseq_registered ();
+  xpthread_join (xpthread_create (NULL, threadfunc, NULL));
+#else
+  TEST_COMPARE (__rseq_size, 0);
+  FAIL_UNSUPPORTED ("rseq not supported on this architecture");
+#endif
+
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,64 @@
+/* Test the alignment of executable segments with glibc.rtld.hugepages.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <link.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <support/check.h>
+#include <support/xdlfcn.h>
+#include <support/xunistd.h>
+
+/* tst-rtld-hugepages-mod.so is linked with a maximum page size of
+   2 MiB, which is the PMD size on the architectures where huge page
+   alignment matters most.  */
+#define MOD_ALIGN (2 * 1024 * 1024)
+
+static int
+do_test (void)
+{
+  int fd = open ("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size",
+		 O_RDONLY);
+  if (fd < 0)
+    FAIL_UNSUPPORTED ("transparent huge pages not supported");
+  char buf[32];
+  ssize_t n = read (fd, buf, sizeof (buf) - 1);
+  xclose (fd);
+  TEST_VERIFY_EXIT (n > 0);
+  buf[n] = '\0';
+  unsigned long int size = strtoul (buf, NULL, 10);
+  if (size > MOD_ALIGN)
+    FAIL_UNSUPPORTED ("huge page size %lu exceeds module alignment", size);
+  printf ("info: huge page size: %lu\n", size);
+
+  /* Load the module several times, so that an aligned address is not
+     just luck.  */
+  for (int i = 0; i < 8; ++i)
+    {
+      void *handle = xdlopen ("tst-rtld-hugepages-mod.so", RTLD_NOW);
+      struct link_map *l;
+      TEST_COMPARE (dlinfo (handle, RTLD_DI_LINKMAP, &l), 0);
+      TEST_COMPARE (l->l_addr % size, 0);
+      xdlclose (handle);
+    }
+
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,56 @@
+/* elision-adapt.h: Lock elision backoff for x86.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _ELISION_ADAPT_H
+#define _ELISION_ADAPT_H 1
+
+/* This is only used by the elision-*.c files.  It cannot be part of
+   elision-conf.h, which is included by lowlevellock.h and therefore
+   indirectly by atomic.h.  */
+
+#include <atomic.h>
+#include <elision-conf.h>
+
+/* Record a failed elision attempt in *ADAPT_COUNT and skip elision for
+   the next SKIP << level acquisitions.  Must not be called inside a
+   transaction.  */
+static inline void
+elision_adapt_abort (short *adapt_count, int skip)
+{
+  short old = atomic_load_relaxed (adapt_count);
+  int level = (old >> ELISION_LEVEL_SHIFT) & ELISION_LEVEL_MAX;
+
+  /* A negative skip count must not spill into the level bits.  */
+  if (skip < 0)
+    skip = 0;
+  if (skip > (ELISION_SKIP_MASK >> level))
+    skip = ELISION_SKIP_MASK;
+  else
+    skip <<= level;
+  if (level < __elision_aconf.max_backoff)
+    level++;
+
+  short new = (level << ELISION_LEVEL_SHIFT) | skip;
+  /* Avoid writing to the lock's cache line if nothing changes.  The value
+     is just a hint, so relaxed MO is sufficient and lost updates are
+     harmless.  */
+  if (old != new)
+    atomic_store_relaxed (adapt_count, new);
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include <init-arch.h>
 #include <elision-conf.h>
 #include <unistd.h>
+#include <ldsodefs.h>
 
 #if HAVE_TUNABLES
 # define TUNABLE_NAMESPACE elision
@@ -40,14 +41,26 @@ struct elision_config __elision_aconf =
        to reasons other than other threads' memory accesses.  Expressed in
        number of lock acquisition attempts.  */
     .skip_lock_internal_abort = 3,
+    /* How often to not attempt to use elision if all retries aborted due
+       to other threads' memory accesses.  Expressed in number of lock
+       acquisition attempts.  */
+    .skip_lock_after_retries = 3,
     /* How often we retry using elision if there is chance for the transaction
        to finish execution (e.g., it wasn't aborted due to the lock being
        already acquired.  */
     .retry_try_xbegin = 3,
     /* Same as SKIP_LOCK_INTERNAL_ABORT but for trylock.  */
     .skip_trylock_internal_abort = 3,
+    /* Maximum backoff level of a lock.  After repeated failures, elision
+       is skipped for up to the skip count shifted left by this many
+       bits.  */
+    .max_backoff = ELISION_LEVEL_MAX,
+    /* Whether to collect and report elision statistics.  */
+    .stats = 0,
   };
 
+struct elision_stats __elision_stats;
+
 #if HAVE_TUNABLES
 static __always_inline void
 do_set_elision_enable (int32_t elision_enable)
@@ -85,8 +98,11 @@ TUNABLE_CALLBACK (set_elision_ ## __name) (tunable_val_t *valp) \
 
 TUNABLE_CALLBACK_FNDECL (skip_lock_busy, int32_t);
 TUNABLE_CALLBACK_FNDECL (skip_lock_internal_abort, int32_t);
+TUNABLE_CALLBACK_FNDECL (skip_lock_after_retries, int32_t);
 TUNABLE_CALLBACK_FNDECL (retry_try_xbegin, int32_t);
 TUNABLE_CALLBACK_FNDECL (skip_trylock_internal_abort, int32_t);
+TUNABLE_CALLBACK_FNDECL (max_backoff, int32_t);
+TUNABLE_CALLBACK_FNDECL (stats, int32_t);
 #endif
 
 /* Initialize elision.  */
@@ -104,12 +120,40 @@ __lll_elision_init (void)
 	       TUNABLE_CALLBACK (set_elision_skip_lock_busy));
   TUNABLE_GET (skip_lock_internal_abort, int32_t,
 	       TUNABLE_CALLBACK (set_elision_skip_lock_internal_abort));
+  TUNABLE_GET (skip_lock_after_retries, int32_t,
+	       TUNABLE_CALLBACK (set_elision_skip_lock_after_retries));
   TUNABLE_GET (tries, int32_t,
 	       TUNABLE_CALLBACK (set_elision_retry_try_xbegin));
   TUNABLE_GET (skip_trylock_internal_abort, int32_t,
 	       TUNABLE_CALLBACK (set_elision_skip_trylock_internal_abort));
+  TUNABLE_GET (max_backoff, int32_t,
+	       TUNABLE_CALLBACK (set_elision_max_backoff));
+  TUNABLE_GET (stats, int32_t,
+	       TUNABLE_CALLBACK (set_elision_stats));
 #endif
 
   if (!__pthread_force_elision)
-    __elision_aconf.retry_try_xbegin = 0; /* Disable elision on rwlocks.  */
+    {
+      __elision_aconf.retry_try_xbegin = 0; /* Disable elision on rwlocks.  */
+      __elision_aconf.stats = 0;
+    }
+}
+
+/* Print the statistics collected if glibc.elision.stats is set.  */
+static void
+__attribute__ ((destructor))
+elision_stats_report (void)
+{
+  if (!__elision_aconf.stats)
+    return;
+
+  _dl_dprintf (STDERR_FILENO,
+	       "elision: %lu committed, %lu aborted because the lock was "
+	       "busy, %lu aborted internally, %lu aborted by conflicts, "
+	       "%lu skipped\n",
+	       atomic_load_relaxed (&__elision_stats.committed),
+	       atomic_load_relaxed (&__elision_stats.aborted_busy),
+	       atomic_load_relaxed (&__elision_stats.aborted_internal),
+	       atomic_load_relaxed (&__elision_stats.aborted_conflict),
+	       atomic_load_relaxed (&__elision_stats.skipped));
 }
@@ -22,7 +22,7 @@
 #include <time.h>
 
 #define ENABLE_ELISION_SUPPORT 1
-#define ELISION_UNLOCK_NEEDS_ADAPT_COUNT 0
+#define ELISION_UNLOCK_NEEDS_ADAPT_COUNT 1
 
 /* Should make sure there is no false sharing on this.  */
 
@@ -30,10 +30,48 @@ struct elision_config
 {
   int skip_lock_busy;
   int skip_lock_internal_abort;
+  int skip_lock_after_retries;
   int retry_try_xbegin;
   int skip_trylock_internal_abort;
+  int max_backoff;
+  int stats;
 };
 
 extern struct elision_config __elision_aconf attribute_hidden;
 
+/* The adaptation counter of a mutex (__data.__elision) holds two fields.
+   The low bits count the lock acquisitions that still have to skip
+   elision; elision is only attempted if they are zero.  The high bits
+   hold the backoff level of the lock, which is incremented whenever an
+   elision attempt fails and decremented whenever an elided critical
+   section commits.  The number of acquisitions skipped after a failure
+   is the configured skip count shifted left by the backoff level, so
+   locks that abort most of the time effectively stop using elision,
+   while other locks in the same process are not affected.  */
+#define ELISION_SKIP_MASK	0x0fff
+#define ELISION_LEVEL_SHIFT	12
+#define ELISION_LEVEL_MAX	7
+
+/* Process-wide elision statistics, only maintained if the
+   glibc.elision.stats tunable is set.  They are never updated inside a
+   transaction, as that would make all transactions conflict.  */
+struct elision_stats
+{
+  unsigned long int committed;
+  unsigned long int aborted_busy;
+  unsigned long int aborted_internal;
+  unsigned long int aborted_conflict;
+  unsigned long int skipped;
+};
+
+extern struct elision_stats __elision_stats attribute_hidden;
+
+/* Count an event in __elision_stats.  Only usable in files compiled
+   with -mrtm that include hle.h.  */
+#define ELISION_STAT_INC(field)						\
+  do									\
+    if (__glibc_unlikely (__elision_aconf.stats) && !_xtest ())		\
+      atomic_fetch_add_relaxed (&__elision_stats.field, 1);		\
+  while (0)
+
 #endif
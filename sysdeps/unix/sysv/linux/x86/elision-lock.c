@@ -20,7 +20,7 @@
 #include "pthreadP.h"
 #include "lowlevellock.h"
 #include "hle.h"
-#include <elision-conf.h>
+#include <elision-adapt.h>
 
 #ifndef EXTRAARG
 #define EXTRAARG
@@ -33,7 +33,8 @@
 
 /* Adaptive lock using transactions.
    By default the lock region is run as a transaction, and when it
-   aborts or the lock is busy the lock adapts itself.  */
+   aborts or the lock is busy the lock adapts itself.  Repeated failures
+   make the lock back off exponentially (see elision-conf.h).  */
 
 int
 __lll_lock_elision (int *futex, short *adapt_count, EXTRAARG int private)
@@ -44,7 +45,8 @@ __lll_lock_elision (int *futex, short *adapt_count, EXTRAARG int private)
      we need to use atomic accesses to avoid data races.  However, the
      value of adapt_count is just a hint, so relaxed MO accesses are
      sufficient.  */
-  if (atomic_load_relaxed (adapt_count) <= 0)
+  short adapt = atomic_load_relaxed (adapt_count);
+  if ((adapt & ELISION_SKIP_MASK) == 0)
     {
       unsigned status;
       int try_xbegin;
@@ -70,30 +72,39 @@ __lll_lock_elision (int *futex, short *adapt_count, EXTRAARG int private)
 			&& _XABORT_CODE (status) == _ABORT_LOCK_BUSY)
 	        {
 		  /* Right now we skip here.  Better would be to wait a bit
-		     and retry.  This likely needs some spinning.  See
-		     above for why relaxed MO is sufficient.  */
-		  if (atomic_load_relaxed (adapt_count)
-		      != aconf.skip_lock_busy)
-		    atomic_store_relaxed (adapt_count, aconf.skip_lock_busy);
+		     and retry.  This likely needs some spinning.  */
+		  elision_adapt_abort (adapt_count, aconf.skip_lock_busy);
+		  ELISION_STAT_INC (aborted_busy);
 		}
 	      /* Internal abort.  There is no chance for retry.
 		 Use the normal locking and next time use lock.
-		 Be careful to avoid writing to the lock.  See above for why
-		 relaxed MO is sufficient.  */
-	      else if (atomic_load_relaxed (adapt_count)
-		  != aconf.skip_lock_internal_abort)
-		atomic_store_relaxed (adapt_count,
-		    aconf.skip_lock_internal_abort);
+		 Be careful to avoid writing to the lock.  */
+	      else
+		{
+		  elision_adapt_abort (adapt_count,
+				       aconf.skip_lock_internal_abort);
+		  ELISION_STAT_INC (aborted_internal);
+		}
 	      break;
 	    }
 	}
+
+      /* All retries aborted due to conflicting memory accesses by other
+	 threads.  Count this as a failure too, so that locks protecting
+	 heavily shared data stop trying transactions.  */
+      if (try_xbegin == 0 && aconf.retry_try_xbegin > 0)
+	{
+	  elision_adapt_abort (adapt_count, aconf.skip_lock_after_retries);
+	  ELISION_STAT_INC (aborted_conflict);
+	}
     }
   else
     {
       /* Use a normal lock until the threshold counter runs out.
-	 Lost updates possible.  */
-      atomic_store_relaxed (adapt_count,
-	  atomic_load_relaxed (adapt_count) - 1);
+	 Lost updates possible.  This only decrements the skip count and
+	 keeps the backoff level.  */
+      atomic_store_relaxed (adapt_count, adapt - 1);
+      ELISION_STAT_INC (skipped);
     }
 
   /* Use a normal lock here.  */
@@ -20,7 +20,7 @@
 #include <pthreadP.h>
 #include <lowlevellock.h>
 #include "hle.h"
-#include <elision-conf.h>
+#include <elision-adapt.h>
 
 #define aconf __elision_aconf
 
@@ -39,7 +39,8 @@ __lll_trylock_elision (int *futex, short *adapt_count)
   /* Only try a transaction if it's worth it.  See __lll_lock_elision for
      why we need atomic accesses.  Relaxed MO is sufficient because this is
      just a hint.  */
-  if (atomic_load_relaxed (adapt_count) <= 0)
+  short adapt = atomic_load_relaxed (adapt_count);
+  if ((adapt & ELISION_SKIP_MASK) == 0)
     {
       unsigned status;
 
@@ -57,18 +58,17 @@ __lll_trylock_elision (int *futex, short *adapt_count)
       if (!(status & _XABORT_RETRY))
         {
           /* Internal abort.  No chance for retry.  For future
-             locks don't try speculation for some time.  See above for MO.  */
-          if (atomic_load_relaxed (adapt_count)
-              != aconf.skip_lock_internal_abort)
-            atomic_store_relaxed (adapt_count, aconf.skip_lock_internal_abort);
+             locks don't try speculation for some time.  */
+	  elision_adapt_abort (adapt_count, aconf.skip_lock_internal_abort);
+	  ELISION_STAT_INC (aborted_internal);
         }
       /* Could do some retries here.  */
     }
   else
     {
       /* Lost updates are possible but harmless (see above).  */
-      atomic_store_relaxed (adapt_count,
-	  atomic_load_relaxed (adapt_count) - 1);
+      atomic_store_relaxed (adapt_count, adapt - 1);
+      ELISION_STAT_INC (skipped);
     }
 
   return lll_trylock (*futex);
@@ -19,14 +19,27 @@
 #include "pthreadP.h"
 #include "lowlevellock.h"
 #include "hle.h"
+#include <elision-conf.h>
 
 int
-__lll_unlock_elision(int *lock, int private)
+__lll_unlock_elision(int *lock, short *adapt_count, int private)
 {
   /* When the lock was free we're in a transaction.
      When you crash here you unlocked a free lock.  */
   if (*lock == 0)
-    _xend();
+    {
+      /* The critical section was elided successfully, so lower the
+	 backoff level of the lock.  This has to happen before the
+	 transaction commits, as the mutex may be destroyed as soon as it
+	 is released (see BZ 20822).  Only write if the level is nonzero,
+	 so that locks that elide well do not add adapt_count to the write
+	 set.  */
+      short adapt = atomic_load_relaxed (adapt_count);
+      if (adapt >= (1 << ELISION_LEVEL_SHIFT))
+	atomic_store_relaxed (adapt_count, adapt - (1 << ELISION_LEVEL_SHIFT));
+      _xend();
+      ELISION_STAT_INC (committed);
+    }
   else
     lll_unlock ((*lock), private);
   return 0;
@@ -0,0 +1,373 @@
+/* Calibration of the memcpy thresholds.  Linux/x86-64 version.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _DL_MEMCPY_CALIBRATION_H
+#define _DL_MEMCPY_CALIBRATION_H
+
+#include <fcntl.h>
+#include <hp-timing.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sysdep.h>
+
+/* If the glibc.cpu.x86_memcpy_calibration tunable names a file, the
+   crossover sizes above which REP MOVSB and non-temporal stores are
+   faster than the vector loop of memmove are measured at startup, and
+   stored in the file for later processes on a CPU of the same model
+   with the same shared cache size.
+
+   This code runs before IRELATIVE relocations are applied in static
+   executables and before the thread pointer is set up, so it does not
+   call any function with an IFUNC, and it makes system calls without
+   setting errno.
+
+   The file consists of the magic number followed by the entries.
+   Entries are only appended, with O_APPEND, so readers see complete
+   entries, or a truncated last entry, which they ignore.  If several
+   processes calibrate concurrently, the file may contain several
+   entries with the same key, and the first one is used.  The file is
+   only used if it is owned by the effective user and not writable by
+   anyone else.  If it cannot be used or written, the thresholds are
+   not measured at all.  */
+
+#define MEMCPY_CALIBRATION_MAGIC 0x003174636d2e646cULL	/* "ld.mct1".  */
+
+struct memcpy_calibration_entry
+{
+  uint32_t kind;
+  uint32_t family;
+  uint32_t model;
+  uint32_t stepping;
+  uint64_t shared;
+  /* The measured thresholds, or 0 if no crossover was found.  */
+  uint64_t non_temporal_threshold;
+  uint64_t rep_movsb_threshold;
+};
+
+/* The copy loops are those of memmove-vec-unaligned-erms.S for large
+   sizes: four vector loads followed by four vector stores.  Buffers
+   are page aligned, and lengths are multiples of four vectors.  */
+typedef long long int calibration_v2di __attribute__ ((vector_size (16)));
+typedef long long int calibration_v4di __attribute__ ((vector_size (32)));
+
+static void
+inhibit_loop_to_libcall
+calibration_copy_sse2 (void *dst, const void *src, size_t len,
+		       bool non_temporal)
+{
+  calibration_v2di *d = dst;
+  const calibration_v2di *s = src;
+  size_t n = len / sizeof (*d);
+  if (non_temporal)
+    {
+      for (size_t i = 0; i < n; i += 4)
+	{
+	  calibration_v2di v0 = s[i], v1 = s[i + 1];
+	  calibration_v2di v2 = s[i + 2], v3 = s[i + 3];
+	  __builtin_ia32_movntdq (&d[i], v0);
+	  __builtin_ia32_movntdq (&d[i + 1], v1);
+	  __builtin_ia32_movntdq (&d[i + 2], v2);
+	  __builtin_ia32_movntdq (&d[i + 3], v3);
+	}
+      __builtin_ia32_sfence ();
+    }
+  else
+    for (size_t i = 0; i < n; i += 4)
+      {
+	calibration_v2di v0 = s[i], v1 = s[i + 1];
+	calibration_v2di v2 = s[i + 2], v3 = s[i + 3];
+	d[i] = v0;
+	d[i + 1] = v1;
+	d[i + 2] = v2;
+	d[i + 3] = v3;
+      }
+}
+
+static void
+__attribute__ ((target ("avx")))
+inhibit_loop_to_libcall
+calibration_copy_avx (void *dst, const void *src, size_t len,
+		      bool non_temporal)
+{
+  calibration_v4di *d = dst;
+  const calibration_v4di *s = src;
+  size_t n = len / sizeof (*d);
+  if (non_temporal)
+    {
+      for (size_t i = 0; i < n; i += 4)
+	{
+	  calibration_v4di v0 = s[i], v1 = s[i + 1];
+	  calibration_v4di v2 = s[i + 2], v3 = s[i + 3];
+	  __builtin_ia32_movntdq256 (&d[i], v0);
+	  __builtin_ia32_movntdq256 (&d[i + 1], v1);
+	  __builtin_ia32_movntdq256 (&d[i + 2], v2);
+	  __builtin_ia32_movntdq256 (&d[i + 3], v3);
+	}
+      __builtin_ia32_sfence ();
+    }
+  else
+    for (size_t i = 0; i < n; i += 4)
+      {
+	calibration_v4di v0 = s[i], v1 = s[i + 1];
+	calibration_v4di v2 = s[i + 2], v3 = s[i + 3];
+	d[i] = v0;
+	d[i + 1] = v1;
+	d[i + 2] = v2;
+	d[i + 3] = v3;
+      }
+}
+
+static void
+calibration_copy_rep_movsb (void *dst, const void *src, size_t len)
+{
+  asm volatile ("rep movsb"
+		: "+D" (dst), "+S" (src), "+c" (len)
+		:
+		: "memory");
+}
+
+enum calibration_copy
+{
+  copy_vector,
+  copy_non_temporal,
+  copy_rep_movsb
+};
+
+/* Return the shortest of RUNS times of copying LEN bytes from SRC to
+   DST with KIND.  AVX selects 32-byte vectors.  */
+static hp_timing_t
+calibration_time (enum calibration_copy kind, bool avx, void *dst,
+		  const void *src, size_t len, int runs)
+{
+  hp_timing_t best = 0;
+  for (int i = 0; i < runs; ++i)
+    {
+      hp_timing_t start, stop;
+      HP_TIMING_NOW (start);
+      if (kind == copy_rep_movsb)
+	calibration_copy_rep_movsb (dst, src, len);
+      else if (avx)
+	calibration_copy_avx (dst, src, len, kind == copy_non_temporal);
+      else
+	calibration_copy_sse2 (dst, src, len, kind == copy_non_temporal);
+      HP_TIMING_NOW (stop);
+      if (i == 0 || stop - start < best)
+	best = stop - start;
+    }
+  return best;
+}
+
+/* Return the smallest of the sizes MIN, 2 * MIN, ..., MAX from which
+   on copying with KIND is not slower than with the vector loop, or 0
+   if copying MAX bytes with KIND is slower.  */
+static size_t
+calibration_crossover (enum calibration_copy kind, bool avx, void *dst,
+		       const void *src, size_t min, size_t max, int runs)
+{
+  size_t result = 0;
+  for (size_t len = min; len <= max; len *= 2)
+    {
+      hp_timing_t vector = calibration_time (copy_vector, avx, dst, src,
+					     len, runs);
+      hp_timing_t other = calibration_time (kind, avx, dst, src, len, runs);
+      if (other > vector)
+	result = 0;
+      else if (result == 0)
+	result = len;
+    }
+  return result;
+}
+
+/* Measure the thresholds for the CPU described by ENTRY.  */
+static void
+calibration_measure (const struct cpu_features *cpu_features,
+		     unsigned int minimum_rep_movsb_threshold,
+		     struct memcpy_calibration_entry *entry)
+{
+  bool avx = CPU_FEATURE_PREFERRED_P (cpu_features,
+				      AVX_Fast_Unaligned_Load);
+  bool erms = CPU_FEATURE_USABLE_P (cpu_features, ERMS);
+
+  /* The REP MOVSB threshold must be greater than the minimum, which
+     is a power of 2.  */
+  size_t movsb_min = 2 * minimum_rep_movsb_threshold;
+  size_t movsb_max = 64 * 1024;
+
+  /* Non-temporal stores are tried around the per-thread share of the
+     shared cache, where the default threshold is.  */
+  size_t nt_min = 0;
+  if (entry->shared >= 4 * movsb_max)
+    {
+      nt_min = movsb_max;
+      while (2 * nt_min <= entry->shared / 4)
+	nt_min *= 2;
+    }
+  size_t nt_max = 16 * nt_min;
+
+  size_t size = nt_max > movsb_max ? nt_max : movsb_max;
+  long int map = INTERNAL_SYSCALL_CALL (mmap, NULL, 2 * size,
+					PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (INTERNAL_SYSCALL_ERROR_P (map))
+    return;
+  char *src = (char *) map;
+  char *dst = src + size;
+
+  /* The first run of each size faults in the pages, so it is never the
+     shortest one.  */
+  if (erms)
+    entry->rep_movsb_threshold
+      = calibration_crossover (copy_rep_movsb, avx, dst, src, movsb_min,
+			       movsb_max, 16);
+  if (nt_min != 0)
+    entry->non_temporal_threshold
+      = calibration_crossover (copy_non_temporal, avx, dst, src, nt_min,
+			       nt_max, 4);
+
+  INTERNAL_SYSCALL_CALL (munmap, src, 2 * size);
+}
+
+static bool
+calibration_same_key (const struct memcpy_calibration_entry *a,
+		      const struct memcpy_calibration_entry *b)
+{
+  return (a->kind == b->kind && a->family == b->family
+	  && a->model == b->model && a->stepping == b->stepping
+	  && a->shared == b->shared);
+}
+
+/* Return true if FD refers to a file which can be trusted.  */
+static bool
+calibration_file_ok (int fd)
+{
+  struct stat64 st;
+  return (!INTERNAL_SYSCALL_ERROR_P (INTERNAL_SYSCALL_CALL (fstat, fd, &st))
+	  && S_ISREG (st.st_mode)
+	  && st.st_uid == (uid_t) INTERNAL_SYSCALL_CALL (geteuid)
+	  && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0);
+}
+
+/* Open the file PATH for looking up and appending results, creating it
+   if needed.  Set *CREATED if the file was created.  Return -1 if the
+   file cannot be trusted or written, so that the results of a
+   measurement could not be kept.  */
+static int
+calibration_open (const char *path, bool *created)
+{
+  int fd = INTERNAL_SYSCALL_CALL (openat, AT_FDCWD, path,
+				  O_RDWR | O_APPEND | O_CREAT | O_EXCL
+				  | O_NOFOLLOW | O_CLOEXEC, S_IRUSR | S_IWUSR);
+  if (!INTERNAL_SYSCALL_ERROR_P (fd))
+    {
+      uint64_t magic = MEMCPY_CALIBRATION_MAGIC;
+      if (INTERNAL_SYSCALL_CALL (write, fd, &magic, sizeof (magic))
+	  != sizeof (magic))
+	{
+	  INTERNAL_SYSCALL_CALL (close, fd);
+	  return -1;
+	}
+      *created = true;
+      return fd;
+    }
+
+  *created = false;
+  fd = INTERNAL_SYSCALL_CALL (openat, AT_FDCWD, path,
+			      O_RDWR | O_APPEND | O_NOFOLLOW | O_CLOEXEC);
+  if (INTERNAL_SYSCALL_ERROR_P (fd))
+    return -1;
+  uint64_t magic;
+  if (!calibration_file_ok (fd)
+      || INTERNAL_SYSCALL_CALL (read, fd, &magic, sizeof (magic))
+	 != sizeof (magic)
+      || magic != MEMCPY_CALIBRATION_MAGIC)
+    {
+      INTERNAL_SYSCALL_CALL (close, fd);
+      return -1;
+    }
+  return fd;
+}
+
+/* Look up the thresholds for the key of ENTRY in the file FD, whose
+   magic number has been read.  Return true if they are found.  */
+static bool
+calibration_lookup (int fd, struct memcpy_calibration_entry *entry)
+{
+  struct memcpy_calibration_entry buf[16];
+  while (true)
+    {
+      long int n = INTERNAL_SYSCALL_CALL (read, fd, buf, sizeof (buf));
+      if (INTERNAL_SYSCALL_ERROR_P (n) || n < (long int) sizeof (buf[0]))
+	return false;
+      /* A short read only happens at the end of the file.  A partial
+	 entry there is ignored.  */
+      for (size_t i = 0; i < n / sizeof (buf[0]); ++i)
+	if (calibration_same_key (&buf[i], entry))
+	  {
+	    entry->non_temporal_threshold = buf[i].non_temporal_threshold;
+	    entry->rep_movsb_threshold = buf[i].rep_movsb_threshold;
+	    return true;
+	  }
+    }
+}
+
+/* Replace *NON_TEMPORAL_THRESHOLD and *REP_MOVSB_THRESHOLD with the
+   crossover sizes measured on this CPU, using the file PATH as cache
+   of the results.  SHARED is the share of the shared cache of one
+   thread.  The thresholds are left unchanged where they cannot be
+   measured.  Nothing is measured if the results cannot be stored in
+   PATH, as every process would repeat the measurement otherwise.  */
+static void
+dl_memcpy_calibrate (const struct cpu_features *cpu_features,
+		     const char *path, long int shared,
+		     unsigned int minimum_rep_movsb_threshold,
+		     unsigned long int *non_temporal_threshold,
+		     unsigned int *rep_movsb_threshold)
+{
+  bool created;
+  int fd = calibration_open (path, &created);
+  if (fd < 0)
+    return;
+
+  struct memcpy_calibration_entry entry;
+  entry.kind = cpu_features->basic.kind;
+  entry.family = cpu_features->basic.family;
+  entry.model = cpu_features->basic.model;
+  entry.stepping = cpu_features->basic.stepping;
+  entry.shared = shared > 0 ? shared : 0;
+  entry.non_temporal_threshold = 0;
+  entry.rep_movsb_threshold = 0;
+
+  if (created || !calibration_lookup (fd, &entry))
+    {
+      calibration_measure (cpu_features, minimum_rep_movsb_threshold,
+			   &entry);
+      /* The file is opened with O_APPEND, so this adds the entry at the
+	 end even if another process has appended to it meanwhile.  */
+      INTERNAL_SYSCALL_CALL (write, fd, &entry, sizeof (entry));
+    }
+  INTERNAL_SYSCALL_CALL (close, fd);
+
+  if (entry.non_temporal_threshold != 0)
+    *non_temporal_threshold = entry.non_temporal_threshold;
+  if (entry.rep_movsb_threshold != 0)
+    *rep_movsb_threshold = entry.rep_movsb_threshold;
+}
+
+#endif /* dl-memcpy-calibration.h */
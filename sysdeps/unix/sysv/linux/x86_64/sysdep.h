@@ -430,4 +430,8 @@
    from stack size.  */
 #define STACK_SIZE_TO_SHADOW_STACK_SIZE_SHIFT 5
 
+/* Provide a clone3 wrapper, __clone3, which is used by __clone_internal
+   before falling back to clone.  */
+#define HAVE_CLONE3_WRAPPER 1
+
 #endif /* linux/x86_64/sysdep.h */
@@ -0,0 +1,116 @@
+/* Test memcpy with glibc.cpu.x86_memcpy_calibration.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/xunistd.h>
+#include <sys/stat.h>
+
+/* The layout of the cache file, see dl-memcpy-calibration.h.  */
+#define CALIBRATION_MAGIC 0x003174636d2e646cULL
+#define CALIBRATION_ENTRY_SIZE 40
+
+/* Return the file named by the tunable, which is the only one set.  */
+static const char *
+calibration_path (void)
+{
+  static const char prefix[] = "glibc.cpu.x86_memcpy_calibration=";
+  const char *tunables = getenv ("GLIBC_TUNABLES");
+  TEST_VERIFY_EXIT (tunables != NULL);
+  TEST_VERIFY_EXIT (strncmp (tunables, prefix, strlen (prefix)) == 0);
+  return tunables + strlen (prefix);
+}
+
+/* Check that the calibration at startup left a valid cache file behind,
+   or none at all if its directory does not exist.  */
+static void
+check_file (const char *path)
+{
+  struct stat64 st;
+  if (stat64 (path, &st) != 0)
+    {
+#ifdef EXPECT_NO_FILE
+      TEST_COMPARE (errno, ENOENT);
+      return;
+#else
+      FAIL_EXIT1 ("stat64 (\"%s\"): %m", path);
+#endif
+    }
+#ifdef EXPECT_NO_FILE
+  FAIL_EXIT1 ("%s exists", path);
+#endif
+
+  TEST_VERIFY (S_ISREG (st.st_mode));
+  TEST_COMPARE (st.st_uid, geteuid ());
+  TEST_COMPARE (st.st_mode & (S_IWGRP | S_IWOTH), 0);
+  /* The magic number and at least the entry for this CPU.  */
+  TEST_VERIFY (st.st_size >= 8 + CALIBRATION_ENTRY_SIZE);
+  TEST_COMPARE ((st.st_size - 8) % CALIBRATION_ENTRY_SIZE, 0);
+
+  int fd = xopen (path, O_RDONLY, 0);
+  uint64_t magic;
+  TEST_COMPARE (read (fd, &magic, sizeof (magic)), sizeof (magic));
+  TEST_VERIFY (magic == CALIBRATION_MAGIC);
+  xclose (fd);
+}
+
+/* Check memcpy and memmove with sizes around any thresholds the
+   calibration may have chosen.  */
+static void
+check_copies (void)
+{
+  size_t max = 32 * 1024 * 1024;
+  unsigned char *src = xmalloc (max + 64);
+  unsigned char *dst = xmalloc (max + 64);
+  for (size_t i = 0; i < max + 64; ++i)
+    src[i] = i * 7 + (i >> 12);
+
+  for (size_t len = 1; len <= max; len = len * 5 / 4 + 1)
+    for (size_t align = 0; align < 64; align += 21)
+      {
+	memset (dst, 0, len + align);
+	memcpy (dst + align, src + (63 - align), len);
+	TEST_VERIFY (memcmp (dst + align, src + (63 - align), len) == 0);
+
+	/* Overlapping forward and backward moves.  */
+	memcpy (dst, src, len + align);
+	memmove (dst + align, dst, len);
+	TEST_VERIFY (memcmp (dst + align, src, len) == 0);
+	memcpy (dst, src, len + align);
+	memmove (dst, dst + align, len);
+	TEST_VERIFY (memcmp (dst, src + align, len) == 0);
+      }
+
+  free (dst);
+  free (src);
+}
+
+static int
+do_test (void)
+{
+  check_file (calibration_path ());
+  check_copies ();
+  return 0;
+}
+
+#include <support/test-driver.c>
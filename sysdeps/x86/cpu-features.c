@@ -671,6 +671,20 @@ no_cpuid:
 #if HAVE_TUNABLES
   TUNABLE_GET (hwcaps, tunable_val_t *, TUNABLE_CALLBACK (set_hwcaps));
 
+  /* The lazy binding trampolines selected by Prefer_Vector_Resolve do
+     not preserve the MPX bound registers, which may hold parameters if
+     the kernel has enabled them.  */
+  if (CPU_FEATURES_ARCH_P (cpu_features, Prefer_Vector_Resolve)
+      && CPU_FEATURES_CPU_P (cpu_features, OSXSAVE))
+    {
+      unsigned int xcrlow;
+      unsigned int xcrhigh;
+      asm ("xgetbv" : "=a" (xcrlow), "=d" (xcrhigh) : "c" (0));
+      if ((xcrlow & bit_BNDREGS_state) != 0)
+	cpu_features->preferred[index_arch_Prefer_Vector_Resolve]
+	  &= ~bit_arch_Prefer_Vector_Resolve;
+    }
+
   bool disable_xsave_features = false;
 
   if (!CPU_FEATURE_USABLE_P (cpu_features, OSXSAVE))
@@ -265,6 +265,9 @@ TUNABLE_CALLBACK (set_hwcaps) (tunable_val_t *valp)
 	      CHECK_GLIBC_IFUNC_PREFERRED_BOTH (n, cpu_features,
 						Prefer_MAP_32BIT_EXEC,
 						disable, 21);
+	      CHECK_GLIBC_IFUNC_PREFERRED_BOTH (n, cpu_features,
+						Prefer_Vector_Resolve,
+						disable, 21);
 	    }
 	  break;
 	case 23:
@@ -16,6 +16,8 @@
    License along with the GNU C Library; if not, see
    <https://www.gnu.org/licenses/>.  */
 
+#include <dl-memcpy-calibration.h>
+
 static const struct intel_02_cache_info
 {
   unsigned char idx;
@@ -892,6 +894,17 @@ dl_init_cacheinfo (struct cpu_features *cpu_features)
 #endif
     }
 
+#if HAVE_TUNABLES
+  /* Replace the default thresholds with measured ones if requested.
+     Explicitly set thresholds still take precedence.  */
+  const char *calibration = TUNABLE_GET (x86_memcpy_calibration,
+					 const char *, NULL);
+  if (calibration != NULL && *calibration != '\0')
+    dl_memcpy_calibrate (cpu_features, calibration, shared,
+			 minimum_rep_movsb_threshold, &non_temporal_threshold,
+			 &rep_movsb_threshold);
+#endif
+
   unsigned long int rep_movsb_stop_threshold;
   /* ERMS feature is implemented from AMD Zen3 architecture and it is
      performing poorly for data above L2 cache size. Henceforth, adding
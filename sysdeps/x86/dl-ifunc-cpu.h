@@ -0,0 +1,36 @@
+/* CPU state which selects IFUNC implementations.  x86 version.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _DL_IFUNC_CPU_H
+#define _DL_IFUNC_CPU_H
+
+#include <ldsodefs.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* The IFUNC resolvers use the CPU features, after the adjustments
+   made by the glibc.cpu tunables.  */
+static inline bool
+_dl_ifunc_cpu_data (const void **data, size_t *size)
+{
+  *data = &GLRO(dl_x86_cpu_features);
+  *size = sizeof (GLRO(dl_x86_cpu_features));
+  return true;
+}
+
+#endif /* _DL_IFUNC_CPU_H */
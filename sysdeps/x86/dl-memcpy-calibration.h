@@ -0,0 +1,36 @@
+/* Calibration of the memcpy thresholds.  Generic x86 version.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _DL_MEMCPY_CALIBRATION_H
+#define _DL_MEMCPY_CALIBRATION_H
+
+/* Replace *NON_TEMPORAL_THRESHOLD and *REP_MOVSB_THRESHOLD with the
+   crossover sizes measured on this CPU, using the file PATH as cache
+   of the results.  SHARED is the share of the shared cache of one
+   thread.  The thresholds are left unchanged where they cannot be
+   measured.  The calibration is not supported by default.  */
+static inline void
+dl_memcpy_calibrate (const struct cpu_features *cpu_features,
+		     const char *path, long int shared,
+		     unsigned int minimum_rep_movsb_threshold,
+		     unsigned long int *non_temporal_threshold,
+		     unsigned int *rep_movsb_threshold)
+{
+}
+
+#endif /* dl-memcpy-calibration.h */
@@ -793,6 +793,7 @@ enum
 /* XCR0 Feature flags.  */
 #define bit_XMM_state		(1u << 1)
 #define bit_YMM_state		(1u << 2)
+#define bit_BNDREGS_state	(1u << 3)
 #define bit_Opmask_state	(1u << 5)
 #define bit_ZMM0_15_state	(1u << 6)
 #define bit_ZMM16_31_state	(1u << 7)
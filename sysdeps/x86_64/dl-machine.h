@@ -68,6 +68,9 @@ elf_machine_runtime_setup (struct link_map *l, int lazy, int profile)
   extern void _dl_runtime_resolve_fxsave (ElfW(Word)) attribute_hidden;
   extern void _dl_runtime_resolve_xsave (ElfW(Word)) attribute_hidden;
   extern void _dl_runtime_resolve_xsavec (ElfW(Word)) attribute_hidden;
+  extern void _dl_runtime_resolve_sse (ElfW(Word)) attribute_hidden;
+  extern void _dl_runtime_resolve_avx (ElfW(Word)) attribute_hidden;
+  extern void _dl_runtime_resolve_avx512 (ElfW(Word)) attribute_hidden;
   extern void _dl_runtime_profile_sse (ElfW(Word)) attribute_hidden;
   extern void _dl_runtime_profile_avx (ElfW(Word)) attribute_hidden;
   extern void _dl_runtime_profile_avx512 (ElfW(Word)) attribute_hidden;
@@ -115,8 +118,23 @@ elf_machine_runtime_setup (struct link_map *l, int lazy, int profile)
 	{
 	  /* This function will get called to fix up the GOT entry
 	     indicated by the offset on the stack, and then jump to
-	     the resolved address.  */
-	  if (GLRO(dl_x86_cpu_features).xsave_state_size != 0)
+	     the resolved address.  Saving only the vector registers
+	     used for parameter passing is cheaper than saving the whole
+	     extended state, but does not preserve registers which other
+	     calling conventions may use for parameters.  */
+	  if (CPU_FEATURE_PREFERRED (Prefer_Vector_Resolve))
+	    {
+	      if (CPU_FEATURE_USABLE (AVX512F))
+		*(ElfW(Addr) *) (got + 2)
+		  = (ElfW(Addr)) &_dl_runtime_resolve_avx512;
+	      else if (CPU_FEATURE_USABLE (AVX))
+		*(ElfW(Addr) *) (got + 2)
+		  = (ElfW(Addr)) &_dl_runtime_resolve_avx;
+	      else
+		*(ElfW(Addr) *) (got + 2)
+		  = (ElfW(Addr)) &_dl_runtime_resolve_sse;
+	    }
+	  else if (GLRO(dl_x86_cpu_features).xsave_state_size != 0)
 	    *(ElfW(Addr) *) (got + 2)
 	      = (CPU_FEATURE_USABLE (XSAVEC)
 		 ? (ElfW(Addr)) &_dl_runtime_resolve_xsavec
@@ -255,6 +273,8 @@ elf_machine_plt_value (struct link_map *map, const ElfW(Rela) *reloc,
 
 #ifdef RESOLVE_MAP
 
+#include <dl-ifunc-cache.h>
+
 /* Perform the relocation specified by RELOC and SYM (which is fully resolved).
    MAP is the object containing the reloc.  */
 
@@ -328,7 +348,7 @@ and creates an unsatisfiable circular dependency.\n",
 				  strtab + refsym->st_name);
 	    }
 # endif
-	  value = ((ElfW(Addr) (*) (void)) value) ();
+	  value = _dl_ifunc_resolve (map, sym_map, value);
 	}
 
       switch (r_type)
@@ -514,7 +534,7 @@ and creates an unsatisfiable circular dependency.\n",
 	case R_X86_64_IRELATIVE:
 	  value = map->l_addr + reloc->r_addend;
 	  if (__glibc_likely (!skip_ifunc))
-	    value = ((ElfW(Addr) (*) (void)) value) ();
+	    value = _dl_ifunc_resolve (map, map, value);
 	  *reloc_addr = value;
 	  break;
 	default:
@@ -586,7 +606,7 @@ elf_machine_lazy_rel (struct link_map *map,
     {
       ElfW(Addr) value = map->l_addr + reloc->r_addend;
       if (__glibc_likely (!skip_ifunc))
-	value = ((ElfW(Addr) (*) (void)) value) ();
+	value = _dl_ifunc_resolve (map, map, value);
       *reloc_addr = value;
     }
   else
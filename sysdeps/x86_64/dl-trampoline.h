@@ -41,13 +41,21 @@
 #   if (REGISTER_SAVE_AREA % 16) != 0
 #    error REGISTER_SAVE_AREA must be multples of 16
 #   endif
+#  elif defined USE_VEC_SAVE
+/* Save only the vector registers used for parameter passing.  */
+#   define REGISTER_SAVE_AREA	(8 * VEC_SIZE + STATE_SAVE_OFFSET)
 #  endif
 # else
-#  ifndef USE_FXSAVE
-#   error USE_FXSAVE must be defined
+#  if !defined USE_FXSAVE && !defined USE_VEC_SAVE
+#   error USE_FXSAVE or USE_VEC_SAVE must be defined
 #  endif
+#  ifdef USE_FXSAVE
 /* Use fxsave to save XMM registers.  */
-#  define REGISTER_SAVE_AREA	(512 + STATE_SAVE_OFFSET + 8)
+#   define REGISTER_SAVE_AREA	(512 + STATE_SAVE_OFFSET + 8)
+#  else
+/* Save only the vector registers used for parameter passing.  */
+#   define REGISTER_SAVE_AREA	(8 * VEC_SIZE + STATE_SAVE_OFFSET + 8)
+#  endif
 /* Local stack area before jumping to function address:  All saved
    registers.  */
 #  define LOCAL_STORAGE_AREA	REGISTER_SAVE_AREA
@@ -99,6 +107,15 @@ _dl_runtime_resolve:
 	movq %r9, REGISTER_SAVE_R9(%rsp)
 # ifdef USE_FXSAVE
 	fxsave STATE_SAVE_OFFSET(%rsp)
+# elif defined USE_VEC_SAVE
+	VMOVA %VEC(0), (STATE_SAVE_OFFSET + VEC_SIZE * 0)(%rsp)
+	VMOVA %VEC(1), (STATE_SAVE_OFFSET + VEC_SIZE * 1)(%rsp)
+	VMOVA %VEC(2), (STATE_SAVE_OFFSET + VEC_SIZE * 2)(%rsp)
+	VMOVA %VEC(3), (STATE_SAVE_OFFSET + VEC_SIZE * 3)(%rsp)
+	VMOVA %VEC(4), (STATE_SAVE_OFFSET + VEC_SIZE * 4)(%rsp)
+	VMOVA %VEC(5), (STATE_SAVE_OFFSET + VEC_SIZE * 5)(%rsp)
+	VMOVA %VEC(6), (STATE_SAVE_OFFSET + VEC_SIZE * 6)(%rsp)
+	VMOVA %VEC(7), (STATE_SAVE_OFFSET + VEC_SIZE * 7)(%rsp)
 # else
 	movl $STATE_SAVE_MASK, %eax
 	xorl %edx, %edx
@@ -128,6 +145,15 @@ _dl_runtime_resolve:
 	# Get register content back.
 # ifdef USE_FXSAVE
 	fxrstor STATE_SAVE_OFFSET(%rsp)
+# elif defined USE_VEC_SAVE
+	VMOVA (STATE_SAVE_OFFSET + VEC_SIZE * 0)(%rsp), %VEC(0)
+	VMOVA (STATE_SAVE_OFFSET + VEC_SIZE * 1)(%rsp), %VEC(1)
+	VMOVA (STATE_SAVE_OFFSET + VEC_SIZE * 2)(%rsp), %VEC(2)
+	VMOVA (STATE_SAVE_OFFSET + VEC_SIZE * 3)(%rsp), %VEC(3)
+	VMOVA (STATE_SAVE_OFFSET + VEC_SIZE * 4)(%rsp), %VEC(4)
+	VMOVA (STATE_SAVE_OFFSET + VEC_SIZE * 5)(%rsp), %VEC(5)
+	VMOVA (STATE_SAVE_OFFSET + VEC_SIZE * 6)(%rsp), %VEC(6)
+	VMOVA (STATE_SAVE_OFFSET + VEC_SIZE * 7)(%rsp), %VEC(7)
 # else
 	movl $STATE_SAVE_MASK, %eax
 	xorl %edx, %edx
@@ -0,0 +1,265 @@
+/* memmem, strstr and strcasestr with vector filtering of candidates.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* This file is included with VEC_SIZE defined to 32 (AVX2) or 64
+   (AVX-512), and with one of MEMMEM, STRSTR and STRCASESTR defined to
+   the name of the function to define.  GENERIC is the function which
+   is used for short haystacks and as fallback.
+
+   For VEC_SIZE consecutive start positions at once, the bytes at the
+   start positions are compared with the first byte of the needle, and
+   the bytes at the start positions plus the length of the needle
+   minus 1 with its last byte.  Only the positions at which both match
+   are compared with the whole needle.  For typical text, this skips
+   almost all positions.  The number of candidates is not bounded,
+   though: for a haystack of 'a' and the needle "aba", every position
+   is a candidate.  Therefore the work spent on verifying candidates is
+   limited relative to the number of positions searched, and once the
+   limit is exceeded, the rest of the haystack is searched with
+   GENERIC, which has linear worst-case complexity (it uses the
+   Two-Way algorithm of str-two-way.h for such needles).  */
+
+#include <ctype.h>
+#include <immintrin.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/param.h>
+
+#if VEC_SIZE == 32
+typedef __m256i vec_t;
+typedef uint32_t mask_t;
+# define VEC_LOADU(p) _mm256_loadu_si256 ((const __m256i *) (p))
+# define VEC_SET1(c) _mm256_set1_epi8 ((char) (c))
+# define VEC_EQ(v, c) \
+  ((mask_t) _mm256_movemask_epi8 (_mm256_cmpeq_epi8 ((v), (c))))
+# define MASK_INDEX(m) __builtin_ctz (m)
+# define STRSTR_SECTION ".text.avx"
+#elif VEC_SIZE == 64
+typedef __m512i vec_t;
+typedef uint64_t mask_t;
+# define VEC_LOADU(p) _mm512_loadu_si512 ((const void *) (p))
+# define VEC_SET1(c) _mm512_set1_epi8 ((char) (c))
+# define VEC_EQ(v, c) ((mask_t) _mm512_cmpeq_epi8_mask ((v), (c)))
+# define MASK_INDEX(m) __builtin_ctzll (m)
+# define STRSTR_SECTION ".text.evex512"
+#else
+# error "VEC_SIZE must be 32 or 64"
+#endif
+
+struct needle
+{
+  const unsigned char *s;
+  size_t len;
+  /* The first and last byte of the needle.  */
+  vec_t first;
+  vec_t last;
+#ifdef STRCASESTR
+  /* The bytes which are equal to them ignoring case.  */
+  vec_t first_alt;
+  vec_t last_alt;
+#endif
+};
+
+/* Return the mask of the start positions P to P + VEC_SIZE - 1 at
+   which the first and last byte of NE match.  */
+static __always_inline mask_t
+candidates (const unsigned char *p, const struct needle *ne)
+{
+  vec_t head = VEC_LOADU (p);
+  vec_t tail = VEC_LOADU (p + ne->len - 1);
+#ifdef STRCASESTR
+  return ((VEC_EQ (head, ne->first) | VEC_EQ (head, ne->first_alt))
+	  & (VEC_EQ (tail, ne->last) | VEC_EQ (tail, ne->last_alt)));
+#else
+  return VEC_EQ (head, ne->first) & VEC_EQ (tail, ne->last);
+#endif
+}
+
+/* Return true if NE occurs at the candidate position P.  */
+static __always_inline bool
+verify (const unsigned char *p, const struct needle *ne)
+{
+#ifdef STRCASESTR
+  for (size_t i = 1; i < ne->len - 1; ++i)
+    if (tolower (p[i]) != tolower (ne->s[i]))
+      return false;
+  return true;
+#else
+  /* Check the second byte before calling memcmp, which makes most
+     mismatching candidates cheap.  */
+  return (p[1] == ne->s[1]
+	  && memcmp (p + 2, ne->s + 2, ne->len - 2) == 0);
+#endif
+}
+
+/* Search the HS_LEN bytes at HS, where HS_LEN is at least
+   NE->len - 1 + VEC_SIZE, for NE.  Return the first match, or NULL.
+   If verifying candidates becomes too expensive, set *RESTART to the
+   first start position which has not been excluded and return NULL,
+   so that the caller continues with the generic implementation.  */
+static __always_inline const unsigned char *
+search (const unsigned char *hs, size_t hs_len, const struct needle *ne,
+	size_t *restart)
+{
+  /* Start positions from LAST_POS on are checked with the last
+     vector, whose loads end at the end of the haystack.  */
+  size_t last_pos = hs_len - ne->len + 1 - VEC_SIZE;
+  size_t pos = 0;
+  mask_t keep = ~(mask_t) 0;
+  size_t work = 0;
+
+  while (true)
+    {
+      mask_t m = candidates (hs + pos, ne) & keep;
+      while (m != 0)
+	{
+	  size_t i = pos + MASK_INDEX (m);
+	  if (verify (hs + i, ne))
+	    return hs + i;
+	  work += ne->len;
+	  if (work > 8 * i + 16 * ne->len)
+	    {
+	      *restart = i + 1;
+	      return NULL;
+	    }
+	  m &= m - 1;
+	}
+
+      if (pos == last_pos)
+	return NULL;
+      pos += VEC_SIZE;
+      if (pos > last_pos)
+	{
+	  /* Do not check the positions before POS twice.  */
+	  keep = ~(mask_t) 0 << (pos - last_pos);
+	  pos = last_pos;
+	}
+    }
+}
+
+#ifdef STRCASESTR
+/* Set *ALT to the byte other than C which is equal to C ignoring case,
+   or to C if there is none.  The only candidates are the lowercase and
+   uppercase forms of C.  Return false if two of them are different
+   from C, as a single alternative cannot cover both.  */
+static __always_inline bool
+case_alternative (unsigned char c, unsigned char *alt)
+{
+  int lower = tolower (c);
+  const int forms[] = { lower, toupper (lower), toupper (c) };
+  *alt = c;
+  for (size_t i = 0; i < sizeof (forms) / sizeof (forms[0]); ++i)
+    if (forms[i] != c && forms[i] != *alt && tolower (forms[i]) == lower)
+      {
+	if (*alt != c)
+	  return false;
+	*alt = forms[i];
+      }
+  return true;
+}
+#endif
+
+/* Initialize *NE for the needle S of LEN bytes, which is at least 2.
+   Return false if the needle cannot be searched with vectors.  */
+static __always_inline bool
+init_needle (struct needle *ne, const unsigned char *s, size_t len)
+{
+  ne->s = s;
+  ne->len = len;
+  ne->first = VEC_SET1 (s[0]);
+  ne->last = VEC_SET1 (s[len - 1]);
+#ifdef STRCASESTR
+  unsigned char first_alt, last_alt;
+  if (!case_alternative (s[0], &first_alt)
+      || !case_alternative (s[len - 1], &last_alt))
+    return false;
+  ne->first_alt = VEC_SET1 (first_alt);
+  ne->last_alt = VEC_SET1 (last_alt);
+#endif
+  return true;
+}
+
+#ifdef MEMMEM
+void *
+__attribute__ ((section (STRSTR_SECTION)))
+MEMMEM (const void *haystack, size_t hs_len, const void *needle,
+	size_t ne_len)
+{
+  /* GENERIC handles the needles of length 0 and 1 with memchr.  */
+  if (ne_len < 2 || hs_len < ne_len - 1 + VEC_SIZE)
+    return GENERIC (haystack, hs_len, needle, ne_len);
+
+  struct needle ne;
+  init_needle (&ne, needle, ne_len);
+  size_t restart = 0;
+  const unsigned char *result = search (haystack, hs_len, &ne, &restart);
+  if (restart != 0)
+    return GENERIC ((const char *) haystack + restart, hs_len - restart,
+		    needle, ne_len);
+  return (void *) result;
+}
+#else /* STRSTR || STRCASESTR */
+# ifdef STRCASESTR
+#  define STRSTR STRCASESTR
+# endif
+char *
+__attribute__ ((section (STRSTR_SECTION)))
+STRSTR (const char *haystack, const char *needle)
+{
+  size_t ne_len = strlen (needle);
+  /* Needles of length 0 and 1 are left to GENERIC.  */
+  if (ne_len < 2)
+    return GENERIC (haystack, needle);
+
+  /* The length of the haystack is not known, and a match may occur
+     early in a long haystack.  Search blocks of STEP start positions,
+     after checking with strnlen that the bytes which are loaded for
+     them are part of the haystack.  STEP is large relative to the
+     needle, so that the bytes which are checked twice do not matter.  */
+  size_t step = MAX (4 * ne_len, 4096);
+  size_t block = step + ne_len - 1;
+  const unsigned char *hs = (const unsigned char *) haystack;
+  size_t hs_len = __strnlen ((const char *) hs, block);
+  if (hs_len < ne_len - 1 + VEC_SIZE)
+    return GENERIC (haystack, needle);
+
+  /* Only set up the needle once the haystack is known to be long
+     enough.  */
+  struct needle ne;
+  if (!init_needle (&ne, (const unsigned char *) needle, ne_len))
+    return GENERIC (haystack, needle);
+
+  while (true)
+    {
+      size_t restart = 0;
+      const unsigned char *result = search (hs, hs_len, &ne, &restart);
+      if (result != NULL)
+	return (char *) result;
+      if (restart != 0)
+	return GENERIC ((const char *) hs + restart, needle);
+      if (hs_len < block)
+	/* This was the end of the haystack.  */
+	return NULL;
+      hs += step;
+      hs_len = __strnlen ((const char *) hs, block);
+      if (hs_len < ne_len - 1 + VEC_SIZE)
+	return GENERIC ((const char *) hs, needle);
+    }
+}
+#endif
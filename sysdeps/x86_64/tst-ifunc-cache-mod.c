@@ -0,0 +1,36 @@
+/* Module with an IFUNC symbol for the IFUNC cache tests.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Number of times the resolver has been called.  */
+int ifunc_cache_resolver_calls;
+
+static int
+value_impl (void)
+{
+  return 42;
+}
+
+static void *
+inhibit_stack_protector
+value_resolver (void)
+{
+  ++ifunc_cache_resolver_calls;
+  return value_impl;
+}
+
+int ifunc_cache_value (void) __attribute__ ((ifunc ("value_resolver")));
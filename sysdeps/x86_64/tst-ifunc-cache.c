@@ -0,0 +1,63 @@
+/* Test that IFUNC resolver results are stored in the IFUNC cache.
+   Copyright (C) 2021 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stdint.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/xstdio.h>
+#include <sys/stat.h>
+
+/* Defined in tst-ifunc-cache-mod.so.  The test is linked with -z now,
+   so the resolver is called during startup.  */
+extern int ifunc_cache_value (void);
+extern int ifunc_cache_resolver_calls;
+
+static int
+do_test (void)
+{
+  TEST_COMPARE (ifunc_cache_value (), 42);
+
+#ifdef EXPECT_CACHED
+  /* tst-ifunc-cache has run before and stored the result.  */
+  TEST_COMPARE (ifunc_cache_resolver_calls, 0);
+#else
+  /* The result may be in the file from an earlier run already.  */
+  TEST_VERIFY (ifunc_cache_resolver_calls <= 1);
+#endif
+
+  /* The file must hold at least the entry for ifunc_cache_value.  */
+  struct
+  {
+    char magic[8];
+    uint64_t cpu_key;
+    uint64_t count;
+  } header;
+  FILE *fp = xfopen (CACHE_FILE, "r");
+  TEST_COMPARE (fread (&header, sizeof (header), 1, fp), 1);
+  TEST_COMPARE_BLOB (header.magic, sizeof (header.magic), "ld.ifc1", 8);
+  TEST_VERIFY (header.count >= 1);
+  struct stat64 st;
+  TEST_COMPARE (fstat64 (fileno (fp), &st), 0);
+  TEST_COMPARE (st.st_size, sizeof (header) + header.count * 3 * 8);
+  TEST_COMPARE (st.st_mode & 0777, 0600);
+  xfclose (fp);
+
+  return 0;
+}
+
+#include <support/test-driver.c>